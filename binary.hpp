@@ -0,0 +1,226 @@
+#pragma once
+#include "ctstd_base.hpp"
+#include "peano.hpp"
+
+/// Binary integers: a list of bits, the least significant bit first and the most significant bit last
+/// The peano integers are unary, so their size grows linearly with their value
+/// The binary integers grow logarithmically, and the operations are O(bits) or O(bits²)
+///
+/// The representation is canonical: the most significant bit is always 1, and zero is Bits<>
+/// Then two binary integers are equal iff their types are the same
+namespace binary {
+
+    namespace detail {
+        struct IsBinaryInteger {};
+
+        template <bool ... bits>
+        constexpr unsigned long long native_value() {
+            unsigned long long res = 0, power = 1;
+            ((res += bits ? power : 0, power <<= 1), ...);
+            return res;
+        }
+    };
+
+    template <bool ... bits>
+    struct Bits : detail::IsBinaryInteger {
+        // the value modulo 2^64, it is only exact if it fits
+        static constexpr unsigned long long value = detail::native_value<bits...>();
+    };
+    template <class T>
+    using is_binary_integer = ctstd::is_base_of<detail::IsBinaryInteger, T>;
+
+    using Zero = Bits<>;
+
+    namespace detail {
+        // Prepends the least significant bit b, keeping the representation canonical
+        template <bool b, class T>
+        struct Prepend {};
+        template <bool b, bool ... bits>
+        struct Prepend<b, Bits<bits...>> {
+            using value = Bits<b, bits...>;
+        };
+        template <bool b>
+        struct Prepend<b, Bits<>> {
+            using value = ctstd::conditional_using<b, Bits<true>, Bits<>>;
+        };
+
+        template <unsigned long long N>
+        struct IntegerImpl {
+            using value = typename Prepend<N % 2 == 1, typename IntegerImpl<N / 2>::value>::value;
+        };
+        template <>
+        struct IntegerImpl<0> {
+            using value = Bits<>;
+        };
+    };
+
+    /// The binary integer of the native value N, in O(log N) depth
+    template <unsigned long long N>
+    using Integer = typename detail::IntegerImpl<N>::value;
+
+    static_assert(std::is_same_v<Integer<6>, Bits<false, true, true>>);
+    static_assert(Integer<1000003>::value == 1000003);
+
+    /// Conversions to and from the peano integers
+    template <class P>
+    using from_peano = Integer<P::value>;
+    template <class B>
+    using to_peano = peano::Integer<B::value>;
+
+    static_assert(std::is_same_v<from_peano<peano::_5>, Bits<true, false, true>>);
+    static_assert(std::is_same_v<to_peano<Integer<12>>, peano::_12>);
+
+    namespace detail {
+        // Ripple-carry addition, bit by bit
+        template <class A, class B, bool carry>
+        struct Add {};
+        template <bool carry>
+        struct Add<Bits<>, Bits<>, carry> {
+            using value = ctstd::conditional_using<carry, Bits<true>, Bits<>>;
+        };
+        template <bool a, bool ... as, bool carry>
+        struct Add<Bits<a, as...>, Bits<>, carry> {
+            using value = typename Add<Bits<a, as...>, Bits<false>, carry>::value;
+        };
+        template <bool b, bool ... bs, bool carry>
+        struct Add<Bits<>, Bits<b, bs...>, carry> {
+            using value = typename Add<Bits<false>, Bits<b, bs...>, carry>::value;
+        };
+        template <bool a, bool ... as, bool b, bool ... bs, bool carry>
+        struct Add<Bits<a, as...>, Bits<b, bs...>, carry> {
+            using value = typename Prepend<
+                a != (b != carry),
+                typename Add<Bits<as...>, Bits<bs...>, (a && b) || (carry && (a != b))>::value
+            >::value;
+        };
+    };
+
+    template <class A, class B>
+    using add = typename detail::Add<A, B, false>::value;
+
+    static_assert(std::is_same_v<add<Integer<1>, Integer<1>>, Integer<2>>);
+    static_assert(std::is_same_v<add<Integer<1000>, Integer<24>>, Integer<1024>>);
+
+    namespace detail {
+        // -1, 0 or 1, like a <=> b
+        template <bool ... as, bool ... bs>
+        constexpr int compare(Bits<as...>, Bits<bs...>) {
+            if (sizeof...(as) != sizeof...(bs)) {
+                return sizeof...(as) < sizeof...(bs) ? -1 : 1;
+            }
+            // the leading false keeps the arrays nonempty
+            bool x[] = {false, as...};
+            bool y[] = {false, bs...};
+            for (unsigned i = sizeof...(as); i > 0; --i) {
+                if (x[i] != y[i]) return x[i] ? 1 : -1;
+            }
+            return 0;
+        }
+    };
+
+    template <class A, class B>
+    using leq = ctstd::conditional_using<(detail::compare(A{}, B{}) <= 0), ctstd::True, ctstd::False>;
+
+    template <class A, class B>
+    using eq = ctstd::is_same<A, B>;
+
+    static_assert(std::is_same_v<leq<Integer<4>, Integer<8>>, ctstd::True>);
+    static_assert(std::is_same_v<leq<Integer<5>, Integer<4>>, ctstd::False>);
+    static_assert(std::is_same_v<leq<Integer<6>, Integer<6>>, ctstd::True>);
+
+    namespace detail {
+        // Subtraction with borrow, for A >= B, Prepend drops the leading zeros
+        template <class A, class B, bool borrow>
+        struct Sub {};
+        template <>
+        struct Sub<Bits<>, Bits<>, false> {
+            using value = Bits<>;
+        };
+        template <bool a, bool ... as, bool borrow>
+        struct Sub<Bits<a, as...>, Bits<>, borrow> {
+            using value = typename Sub<Bits<a, as...>, Bits<false>, borrow>::value;
+        };
+        template <bool a, bool ... as, bool b, bool ... bs, bool borrow>
+        struct Sub<Bits<a, as...>, Bits<b, bs...>, borrow> {
+            using value = typename Prepend<
+                a != (b != borrow),
+                typename Sub<Bits<as...>, Bits<bs...>, (!a && (b || borrow)) || (a && b && borrow)>::value
+            >::value;
+        };
+
+        template <class A, class B>
+        struct Minus {
+            using value = typename Sub<A, B, false>::value;
+        };
+    };
+
+    /// Saturating subtraction, like peano::minus
+    template <class A, class B>
+    using minus = ctstd::lazy_if<(detail::compare(A{}, B{}) <= 0), ctstd::Identity<Zero>, detail::Minus<A, B>>;
+
+    static_assert(std::is_same_v<minus<Integer<1024>, Integer<1>>, Integer<1023>>);
+    static_assert(std::is_same_v<minus<Integer<1024>, Integer<1023>>, Integer<1>>);
+    static_assert(std::is_same_v<minus<Integer<3>, Integer<5>>, Zero>);
+
+    namespace detail {
+        // Shift-and-add multiplication, O(bits²)
+        template <class A, class B>
+        struct Mult {};
+        template <class B>
+        struct Mult<Bits<>, B> {
+            using value = Bits<>;
+        };
+        template <bool a, bool ... as, class B>
+        struct Mult<Bits<a, as...>, B> {
+            using value = add<
+                ctstd::conditional_using<a, B, Bits<>>,
+                typename Prepend<false, typename Mult<Bits<as...>, B>::value>::value
+            >;
+        };
+    };
+
+    template <class A, class B>
+    using mult = typename detail::Mult<A, B>::value;
+
+    static_assert(std::is_same_v<mult<Integer<1000>, Integer<1000>>, Integer<1000000>>);
+    static_assert(std::is_same_v<mult<Integer<0>, Integer<1000>>, Zero>);
+
+    namespace detail {
+        // Long division, from the most significant bit down
+        template <class A, class B>
+        struct DivMod {};
+        template <class B>
+        struct DivMod<Bits<>, B> {
+            static_assert(!std::is_same_v<B, Bits<>>, "division by zero");
+            using value = Bits<>;
+            using remainder = Bits<>;
+        };
+        template <bool a, bool ... as, class B>
+        struct DivMod<Bits<a, as...>, B> {
+            using high = DivMod<Bits<as...>, B>;
+            // the remainder of the higher bits, shifted, with the bit a appended
+            using current = typename Prepend<a, typename high::remainder>::value;
+            static constexpr bool fits = compare(B{}, current{}) <= 0;
+
+            using value = typename Prepend<fits, typename high::value>::value;
+            using remainder = ctstd::lazy_if<fits, Minus<current, B>, ctstd::Identity<current>>;
+        };
+    };
+
+    template <class A, class B>
+    using div = typename detail::DivMod<A, B>::value;
+
+    template <class A, class B>
+    using remainder = typename detail::DivMod<A, B>::remainder;
+
+    static_assert(std::is_same_v<div<Integer<1000000>, Integer<7>>, Integer<142857>>);
+    static_assert(std::is_same_v<remainder<Integer<1000000>, Integer<7>>, Integer<1>>);
+    static_assert(std::is_same_v<div<Integer<3>, Integer<5>>, Zero>);
+    static_assert(std::is_same_v<remainder<Integer<3>, Integer<5>>, Integer<3>>);
+};
+
+// the number of bits of a binary integer, for the checks of its native value
+namespace ctstd::detail {
+    template <bool ... bits>
+    constexpr unsigned native_width<binary::Bits<bits...>> = sizeof...(bits);
+};
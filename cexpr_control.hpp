@@ -220,4 +220,118 @@ namespace cexpr_control {
         unsigned N
     >
     struct DoWhile<func, stopcond, _, N, ctstd::False> {};
-};
\ No newline at end of file
+
+
+    namespace detail {
+        template <class Args, class Func, class Is, class _>
+        struct ForEachImpl {};
+
+        template <class Func, class ... Ts, unsigned ... Is, class _>
+        struct ForEachImpl<argpass::Argpass<Ts...>, Func, std::integer_sequence<unsigned, Is...>, _> :
+            Func:: template __call__<Ts, Pair<WrapInt<Is>, _>>...
+        {};
+    };
+
+    /// For-each loop over the elements of an Argpass
+    /// 
+    /// This template provides compile-time iteration similar to:
+    /// ```cpp
+    /// for (auto elem : list) {
+    ///     func(elem);
+    /// }
+    /// ```
+    /// 
+    /// Unlike DoWhile, the calls aren't nested: they are the base classes of a single
+    /// template. There is no recursion depth limit, and no stop condition variable to read
+    /// after each iteration.
+    /// 
+    /// The calls run in list order only because GCC instantiates base classes left to right.
+    /// Nothing chains a call on the previous one, the standard doesn't promise that order,
+    /// and the ordering tests only run on GCC.
+    /// 
+    /// Template parameters:
+    /// - func: Lambda function to call on each element (struct with __call__<Elem, _> template member)
+    /// - Args: argpass::Argpass of the elements
+    /// - _: Unique lambda type decltype([](){}) required for stateful behavior
+    /// 
+    /// Each call gets its own unique tag Pair<WrapInt<index>, _>, so the calls on equal elements
+    /// are still instantiated separately.
+    /// 
+    /// Example usage:
+    /// ```cpp
+    /// struct AddToSum {
+    ///     template <class Elem, class _>
+    ///     struct __call__ : Assign<sum, ctstd::add<sum, Elem, RE>, RE> {};
+    /// };
+    /// 
+    /// // sum = sum + 1 + 2 + 3
+    /// struct : ForEach<AddToSum, argpass::Argpass<peano::_1, peano::_2, peano::_3>, RE> {};
+    /// ```
+    template <class func, class Args, class _>
+    struct ForEach :
+        detail::ForEachImpl<Args, func, std::make_integer_sequence<unsigned, Args::size>, _>
+    {};
+};
+namespace cexpr_control {
+
+    /// Generator: a lazily produced sequence, pulled one element at a time
+    /// 
+    /// Template parameters:
+    /// - Init: The initial state
+    /// - Step: Lambda function from a state to the next element (struct with __call__<State> template member,
+    ///   whose result has the members `value`, the element, and `next`, the state after it)
+    /// 
+    /// A generator is a tag inheriting from Generator, its state is the variable Pair<Gen, GeneratorState>
+    /// Only the elements which are pulled with NextValue are ever computed
+    /// 
+    /// Example usage:
+    /// ```cpp
+    /// struct CountUp {
+    ///     template <class N>
+    ///     struct __call__ {
+    ///         using value = N;
+    ///         using next = peano::Succ<N>;
+    ///     };
+    /// };
+    /// struct naturals : Generator<peano::Zero, CountUp> {};
+    /// 
+    /// using first = NextValue<naturals, RE>;   // peano::Zero
+    /// using second = NextValue<naturals, RE>;  // peano::_1
+    /// ```
+    template <class Init, class Step>
+    struct Generator {
+        using init = Init;
+        using step = Step;
+    };
+
+    namespace detail {
+        struct GeneratorState {};
+
+        // the state is stored wrapped, so that a step may produce any state, None included
+        template <class State>
+        struct Started {};
+
+        template <class Stored, class Init>
+        struct StateOr {
+            using value = Init;
+        };
+        template <class State, class Init>
+        struct StateOr<Started<State>, Init> {
+            using value = State;
+        };
+
+        template <
+            class Gen, class _,
+            class State = typename StateOr<type_var::value<Pair<Gen, GeneratorState>, _>, typename Gen::init>::value,
+            class Result = typename Gen::step::template __call__<State>
+        >
+        struct NextValueImpl : type_var::Assign<Pair<Gen, GeneratorState>, Started<typename Result::next>, _> {
+            using value = typename Result::value;
+        };
+    };
+
+    /// Advances the generator Gen by one step and returns the element
+    /// Pulling is a side effect, so every use needs a unique _
+    template <class Gen, class _>
+    using NextValue = typename detail::NextValueImpl<Gen, _>::value;
+};
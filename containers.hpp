@@ -0,0 +1,748 @@
+#pragma once
+#include "type_var.hpp"
+#include "cexpr_control.hpp"
+
+/// Containers made of many type variables
+///
+/// Storing a whole Argpass in one variable means rebuilding and re-storing it on every update,
+/// and every read walks the flag chain of all the updates so far.
+/// Instead, each element of a container is its own variable, named by a pair (container, key).
+/// Its flag chain only grows with the writes to that element, so the cost of an access
+/// doesn't depend on the size of the container.
+namespace type_var {
+
+    namespace containers {
+        using cexpr_control::detail::Pair;
+        using cexpr_control::detail::WrapInt;
+
+        // Tags for the bookkeeping variables of the containers
+        struct Length {};
+
+        template <class A, unsigned i>
+        using Slot = Pair<A, WrapInt<i>>;
+
+        // a Num read from a variable, or 0 if the variable wasn't assigned yet
+        template <class T>
+        struct NumOrZero {
+            static constexpr auto value = T::value;
+        };
+        template <>
+        struct NumOrZero<ctstd::None> {
+            static constexpr int value = 0;
+        };
+    };
+
+    /// Arrays: the element i of the array A is the variable Pair<A, WrapInt<i>>
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct arr {};
+    /// struct : ArraySet<arr, 3, int, RE> {};
+    /// static_assert(std::is_same_v<ArrayGet<arr, 3, RE>, int>);
+    /// ```
+    /// The elements which were never set are ctstd::None
+
+    /// Stores V in the element i of the array A
+    template <class A, unsigned i, class V, class _>
+    using ArraySet = Assign<containers::Slot<A, i>, V, _>;
+
+    /// The element i of the array A
+    template <class A, unsigned i, class _>
+    using ArrayGet = value<containers::Slot<A, i>, _>;
+
+    /// The length of the array A, which is 0 until it is resized or pushed to
+    /// ArraySet doesn't change the length, so that it only touches one variable
+    template <class A, class _>
+    constexpr unsigned array_length = containers::NumOrZero<value<containers::Pair<A, containers::Length>, _>>::value;
+
+    /// Sets the length of the array A to n, the elements are kept as they are
+    template <class A, unsigned n, class _>
+    using ArrayResize = Assign_v<containers::Pair<A, containers::Length>, n, _>;
+
+    /// Stores V after the last element of the array A and increments its length
+    template <class A, class V, class _, unsigned n = array_length<A, _>>
+    struct ArrayPushBack :
+        ArraySet<A, n, V, _>,
+        ArrayResize<A, n + 1, _>
+    {};
+};
+
+namespace type_var {
+
+    namespace containers {
+        // the variable telling whether the key K was inserted in the dict D
+        template <class K>
+        struct Present {};
+        // the array of the keys of the dict D, in insertion order
+        struct Keys {};
+
+        template <class D, class K, class IsPresent, class _>
+        struct DictInsertKey :
+            Assign<Pair<D, Present<K>>, ctstd::True, _>,
+            ArrayPushBack<Pair<D, Keys>, K, _>
+        {};
+        template <class D, class K, class _>
+        struct DictInsertKey<D, K, ctstd::True, _> {};
+
+        template <class D, class Is, class _>
+        struct DictKeys {};
+        template <class D, unsigned ... Is, class _>
+        struct DictKeys<D, std::integer_sequence<unsigned, Is...>, _> {
+            using value = argpass::Argpass<ArrayGet<Pair<D, Keys>, Is, _>...>;
+        };
+    };
+
+    /// Dictionaries: the value of the key K in the dict D is the variable Pair<D, K>
+    /// The keys are arbitrary types, and a lookup only reads the variables of its own key
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct dict {};
+    /// struct : DictSet<dict, int, float, RE> {};
+    /// static_assert(std::is_same_v<DictGet<dict, int, RE>, float>);
+    /// ```
+
+    /// Stores V under the key K of the dict D
+    /// A new key is also appended to the key list
+    template <class D, class K, class V, class _, class IsPresent = value<containers::Pair<D, containers::Present<K>>, _>>
+    struct DictSet :
+        Assign<containers::Pair<D, K>, V, _>,
+        containers::DictInsertKey<D, K, IsPresent, _>
+    {};
+
+    /// The value under the key K of the dict D, or ctstd::None if there is none
+    template <class D, class K, class _>
+    using DictGet = value<containers::Pair<D, K>, _>;
+
+    /// ctstd::True if the key K was set in the dict D, even if its value is None
+    template <class D, class K, class _>
+    using DictContains = ctstd::conditional_using<
+        std::is_same_v<value<containers::Pair<D, containers::Present<K>>, _>, ctstd::True>, 
+        ctstd::True, 
+        ctstd::False
+    >;
+
+    /// The keys of the dict D as an argpass::Argpass, in the order they were first set
+    template <class D, class _>
+    using dict_keys = typename containers::DictKeys<
+        D, 
+        std::make_integer_sequence<unsigned, array_length<containers::Pair<D, containers::Keys>, _>>, 
+        _
+    >::value;
+};
+
+namespace type_var {
+
+    namespace containers {
+        // the deque holds the slots [head, tail), the slots are numbered by int so the head can go below 0
+        struct Head {};
+        struct Tail {};
+        template <int i>
+        struct DequeSlot {};
+
+        // Thunk for the slot i of the deque Q, so that an empty deque doesn't read a popped slot
+        template <class Q, int i, class _>
+        struct DequeSlotValue {
+            using value = type_var::value<Pair<Q, DequeSlot<i>>, _>;
+        };
+    };
+
+    /// Deques: the elements of the deque Q are in the variables Pair<Q, DequeSlot<i>> for i in [head, tail)
+    /// The head and the tail indices are variables too, so each operation touches O(1) variables
+    /// and the popped slots are never read again
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct queue {};
+    /// struct : PushBack<queue, int, RE> {};
+    /// struct : PushBack<queue, char, RE> {};
+    /// struct : PopFront<queue, RE> {};
+    /// static_assert(std::is_same_v<Front<queue, RE>, char>);
+    /// ```
+
+    template <class Q, class _>
+    constexpr int deque_head = containers::NumOrZero<value<containers::Pair<Q, containers::Head>, _>>::value;
+    template <class Q, class _>
+    constexpr int deque_tail = containers::NumOrZero<value<containers::Pair<Q, containers::Tail>, _>>::value;
+
+    /// The number of elements of the deque Q
+    template <class Q, class _>
+    constexpr int deque_size = deque_tail<Q, _> - deque_head<Q, _>;
+
+    /// ctstd::True if the deque Q has no elements
+    template <class Q, class _>
+    using Empty = ctstd::conditional_using<deque_size<Q, _> == 0, ctstd::True, ctstd::False>;
+
+    /// The first and the last element of the deque Q, ctstd::None if it is empty
+    template <class Q, class _>
+    using Front = ctstd::lazy_if<
+        deque_size<Q, _> == 0,
+        ctstd::Identity<ctstd::None>,
+        containers::DequeSlotValue<Q, deque_head<Q, _>, _>
+    >;
+    template <class Q, class _>
+    using Back = ctstd::lazy_if<
+        deque_size<Q, _> == 0,
+        ctstd::Identity<ctstd::None>,
+        containers::DequeSlotValue<Q, deque_tail<Q, _> - 1, _>
+    >;
+
+    /// Adds V after the last element of the deque Q
+    template <class Q, class V, class _, int tail = deque_tail<Q, _>>
+    struct PushBack :
+        Assign<containers::Pair<Q, containers::DequeSlot<tail>>, V, _>,
+        Assign_v<containers::Pair<Q, containers::Tail>, tail + 1, _>
+    {};
+
+    /// Adds V before the first element of the deque Q
+    template <class Q, class V, class _, int head = deque_head<Q, _>>
+    struct PushFront :
+        Assign<containers::Pair<Q, containers::DequeSlot<head - 1>>, V, _>,
+        Assign_v<containers::Pair<Q, containers::Head>, head - 1, _>
+    {};
+
+    /// Removes the first element of the deque Q, read it with Front beforehand
+    template <class Q, class _, int head = deque_head<Q, _>, int tail = deque_tail<Q, _>>
+    struct PopFront : Assign_v<containers::Pair<Q, containers::Head>, head + 1, _> {
+        static_assert(head < tail, "PopFront from an empty deque");
+    };
+
+    /// Removes the last element of the deque Q, read it with Back beforehand
+    template <class Q, class _, int head = deque_head<Q, _>, int tail = deque_tail<Q, _>>
+    struct PopBack : Assign_v<containers::Pair<Q, containers::Tail>, tail - 1, _> {
+        static_assert(head < tail, "PopBack from an empty deque");
+    };
+};
+
+namespace type_var {
+
+    /// Records: a group of named fields, each field F of the record R is the variable Pair<R, F>
+    /// Updating a field doesn't touch the other fields, however many there are
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct x {};
+    /// struct y {};
+    /// struct point : Record<x, y> {};
+    /// struct : FieldSet<point, x, peano::_1, RE> {};
+    /// static_assert(std::is_same_v<FieldGet<point, x, RE>, peano::_1>);
+    /// ```
+    template <class ... Fields>
+    struct Record : argpass::Set<Fields...> {
+        using fields = argpass::Argpass<Fields...>;
+    };
+
+    namespace containers {
+        template <class R, class F>
+        struct FieldKey {
+            static_assert(ctstd::to_bool<argpass::contains<R, F>>, "the record has no such field");
+            using value = Pair<R, F>;
+        };
+
+        template <class R, class Fields, class Snapshot, class _>
+        struct RecordRestore {};
+        template <class R, class ... Fields, class ... Vals, class _>
+        struct RecordRestore<R, argpass::Argpass<Fields...>, argpass::Argpass<Vals...>, _> :
+            Assign<Pair<R, Fields>, Vals, _>...
+        {
+            static_assert(sizeof...(Fields) == sizeof...(Vals), "the snapshot doesn't match the fields of the record");
+        };
+
+        template <class R, class Fields, class _>
+        struct RecordSnapshot {};
+        template <class R, class ... Fields, class _>
+        struct RecordSnapshot<R, argpass::Argpass<Fields...>, _> {
+            using value = argpass::Argpass<type_var::value<Pair<R, Fields>, _>...>;
+        };
+    };
+
+    /// Stores V in the field F of the record R
+    template <class R, class F, class V, class _>
+    using FieldSet = Assign<typename containers::FieldKey<R, F>::value, V, _>;
+
+    /// The value of the field F of the record R, ctstd::None if it wasn't set
+    template <class R, class F, class _>
+    using FieldGet = value<typename containers::FieldKey<R, F>::value, _>;
+
+    /// The values of all the fields of the record R as an argpass::Argpass, in the order of the fields
+    template <class R, class _>
+    using record_snapshot = typename containers::RecordSnapshot<R, typename R::fields, _>::value;
+
+    /// Stores the values of a snapshot back in the fields of the record R
+    template <class R, class Snapshot, class _>
+    using RecordRestore = containers::RecordRestore<R, typename R::fields, Snapshot, _>;
+};
+
+namespace type_var {
+
+    /// A handle to the node n of the heap Heap, allocated with Alloc
+    /// The handles of separate heaps are distinct types, so their fields never alias
+    template <class Heap, unsigned n>
+    struct Handle {
+        static constexpr unsigned value = n;
+    };
+
+    namespace containers {
+        struct DefaultHeap {};
+        // the number of nodes allocated in the heap so far
+        struct Allocated {};
+
+        template <class Heap, class _, unsigned n = NumOrZero<value<Pair<Heap, Allocated>, _>>::value>
+        struct AllocImpl : Assign_v<Pair<Heap, Allocated>, n + 1, _> {
+            using value = Handle<Heap, n>;
+        };
+    };
+
+    /// Nodes: the heap hands out the handles 0, 1, 2, ..., and the field F of the node H is the variable Pair<H, F>
+    /// The handles can be stored in the fields of other nodes, which makes linked structures that can be
+    /// updated in place, one field at a time
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct next {};
+    /// using node = Alloc<RE>;
+    /// struct : NodeSet<node, next, Alloc<RE>, RE> {};
+    /// ```
+
+    /// A fresh handle, allocating it is a side effect, so every use needs a unique _
+    /// Separate heaps number their handles independently
+    template <class _, class Heap = containers::DefaultHeap>
+    using Alloc = typename containers::AllocImpl<Heap, _>::value;
+
+    /// Stores V in the field F of the node H
+    template <class H, class F, class V, class _>
+    using NodeSet = Assign<containers::Pair<H, F>, V, _>;
+
+    /// The field F of the node H, ctstd::None if it wasn't set
+    template <class H, class F, class _>
+    using NodeGet = value<containers::Pair<H, F>, _>;
+};
+
+namespace type_var {
+
+    /// Ordered maps over integer keys: peano, binary or ctstd::Num, compared by their value
+    /// The map is a trie over the digits of the keys in base 64, from the most significant one down
+    /// Every trie node is a variable holding the 64-bit mask of its nonempty children, so an operation
+    /// touches one node per digit, and a node is written at most 64 times, once per new child
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct schedule : OrderedMap<16> {};
+    /// struct : MapInsert<schedule, peano::_5, int, RE> {};
+    /// static_assert(std::is_same_v<MapLowerBound<schedule, peano::_3, RE>, peano::_5>);
+    /// ```
+    /// The keys must be less than 2^bits, and the maps have no erase
+    template <unsigned bits = 32>
+    struct OrderedMap {
+        static_assert(0 < bits && bits < 64, "the keys of an OrderedMap have 1 to 63 bits");
+        static constexpr unsigned key_bits = bits;
+        // the number of digits of a key in base 64
+        static constexpr unsigned depth = (bits + 5) / 6;
+    };
+
+    namespace containers {
+        // the trie node at the depth l whose keys start with the digits p
+        template <unsigned l, unsigned long long p>
+        struct TrieNode {};
+        // the key k as it was inserted
+        template <unsigned long long k>
+        struct KeyAt {};
+        template <unsigned long long k>
+        struct ValueAt {};
+
+        // the first l digits of k
+        constexpr unsigned long long trie_prefix(unsigned long long k, unsigned depth, unsigned l) {
+            return 6 * (depth - l) >= 64 ? 0 : k >> 6 * (depth - l);
+        }
+        // the digit l of k, the digit 0 is the most significant one
+        constexpr unsigned trie_digit(unsigned long long k, unsigned depth, unsigned l) {
+            return (k >> 6 * (depth - 1 - l)) % 64;
+        }
+        constexpr unsigned lowest_bit(unsigned long long mask) {
+            unsigned i = 0;
+            while (mask % 2 == 0) {
+                mask >>= 1;
+                ++i;
+            }
+            return i;
+        }
+
+        // a binary key is checked on its own bits, its value is only kept modulo 2^64
+        // the value is shifted in 64 bits, an int key would be shifted by its full width in a 32-bit map
+        template <class M, class K>
+        constexpr bool key_fits = 
+            ctstd::detail::native_width<K> <= M::key_bits && static_cast<unsigned long long>(K::value) >> M::key_bits == 0;
+
+        template <class M, class K>
+        struct MapKey {
+            static_assert(key_fits<M, K>, "the key doesn't fit in the bits of the map");
+            static constexpr unsigned long long value = K::value;
+        };
+
+        template <class M, unsigned l, unsigned long long p, class _>
+        constexpr unsigned long long trie_mask = NumOrZero<value<Pair<M, TrieNode<l, p>>, _>>::value;
+
+        // sets the bit of the child c in the mask of the node (l, p), unless it is set already
+        template <class M, unsigned l, unsigned long long p, unsigned c, class _, unsigned long long mask = trie_mask<M, l, p, _>>
+        struct TrieMark : Assign_v<Pair<M, TrieNode<l, p>>, mask | 1ull << c, _> {};
+        template <class M, unsigned l, unsigned long long p, unsigned c, class _, unsigned long long mask>
+        requires ((mask >> c) % 2 == 1)
+        struct TrieMark<M, l, p, c, _, mask> {};
+
+        template <class M, class K, class Levels, class _>
+        struct TrieInsert {};
+        template <class M, class K, unsigned ... ls, class _>
+        struct TrieInsert<M, K, std::integer_sequence<unsigned, ls...>, _> :
+            TrieMark<M, ls, trie_prefix(K::value, M::depth, ls), trie_digit(K::value, M::depth, ls), _>...
+        {};
+
+        // the smallest key in the nonempty subtree of the node (l, p)
+        template <class M, unsigned l, unsigned long long p, class _, bool leaf = (l == M::depth)>
+        struct TrieMin {
+            static constexpr unsigned long long value =
+                TrieMin<M, l + 1, 64 * p + lowest_bit(trie_mask<M, l, p, _>), _>::value;
+        };
+        template <class M, unsigned l, unsigned long long p, class _>
+        struct TrieMin<M, l, p, _, true> {
+            static constexpr unsigned long long value = p;
+        };
+
+        template <class M, bool found, unsigned l, unsigned long long p, class _>
+        struct TrieFound {
+            using value = type_var::value<Pair<M, KeyAt<TrieMin<M, l, p, _>::value>>, _>;
+        };
+        template <class M, unsigned l, unsigned long long p, class _>
+        struct TrieFound<M, false, l, p, _> {
+            using value = ctstd::None;
+        };
+
+        template <class M, unsigned long long k, class Levels, class _>
+        struct TrieLowerBound {};
+        template <class M, unsigned long long k, unsigned ... ls, class _>
+        struct TrieLowerBound<M, k, std::integer_sequence<unsigned, ls...>, _> {
+            static constexpr unsigned depth = M::depth;
+            // the children of the nodes on the path of k which come after the path
+            static constexpr unsigned long long after[] = {
+                (trie_mask<M, ls, trie_prefix(k, depth, ls), _> & ~((2ull << trie_digit(k, depth, ls)) - 1))...
+            };
+            static constexpr bool exact =
+                (trie_mask<M, depth - 1, trie_prefix(k, depth, depth - 1), _> >> trie_digit(k, depth, depth - 1)) % 2 == 1;
+            // the deepest node on the path which has a child after the path, or -1
+            static constexpr int fork = [] {
+                for (unsigned l = depth; l > 0; --l) {
+                    if (after[l - 1] != 0) return int(l - 1);
+                }
+                return -1;
+            }();
+
+            using value = typename TrieFound<
+                M,
+                exact || fork >= 0,
+                exact ? depth : fork + 1,
+                exact ? k : (fork >= 0 ? 64 * trie_prefix(k, depth, fork) + lowest_bit(after[fork]) : 0),
+                _
+            >::value;
+        };
+
+        template <class M, unsigned long long k, class _>
+        using LowerBound = typename TrieLowerBound<M, k, std::make_integer_sequence<unsigned, M::depth>, _>::value;
+
+        // The range walks the trie one depth at a time, every depth reads all of its nodes in one pack
+        // expansion and keeps the children whose subtrees meet [lo, hi), so there's no recursion per key
+        template <std::size_t n>
+        struct Prefixes {
+            unsigned long long at[n + 1];
+        };
+
+        // the children of the nodes ps which have keys in [lo, hi), written to out unless it's null
+        // the subtree of a child q holds the keys [q << shift, (q + 1) << shift)
+        constexpr std::size_t range_children(
+            const unsigned long long* ps, const unsigned long long* masks, std::size_t n,
+            unsigned shift, unsigned long long lo, unsigned long long hi, unsigned long long* out
+        ) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                for (unsigned c = 0; c < 64; ++c) {
+                    unsigned long long q = 64 * ps[i] + c;
+                    if ((masks[i] >> c) % 2 == 1 && q << shift < hi && (q + 1) << shift > lo) {
+                        if (out) out[count] = q;
+                        ++count;
+                    }
+                }
+            }
+            return count;
+        }
+        template <std::size_t count>
+        constexpr Prefixes<count> range_children_of(
+            const unsigned long long* ps, const unsigned long long* masks, std::size_t n,
+            unsigned shift, unsigned long long lo, unsigned long long hi
+        ) {
+            Prefixes<count> res{};
+            range_children(ps, masks, n, shift, lo, hi, res.at);
+            return res;
+        }
+
+        template <class Level, class Is>
+        struct RangeNext {};
+
+        // the nodes ps at the depth l, and at the bottom the keys themselves
+        template <class M, unsigned long long lo, unsigned long long hi, class _, unsigned l, bool leaf, unsigned long long ... ps>
+        struct RangeLevel {
+            static constexpr unsigned long long prefixes[] = {ps..., 0};
+            static constexpr unsigned long long masks[] = {trie_mask<M, l, ps, _>..., 0};
+            static constexpr unsigned shift = 6 * (M::depth - l - 1);
+            static constexpr std::size_t count = range_children(prefixes, masks, sizeof...(ps), shift, lo, hi, nullptr);
+            static constexpr auto children = range_children_of<count>(prefixes, masks, sizeof...(ps), shift, lo, hi);
+            using value = typename RangeNext<RangeLevel, std::make_index_sequence<count>>::value;
+        };
+        template <class M, unsigned long long lo, unsigned long long hi, class _, unsigned l, unsigned long long ... ps>
+        struct RangeLevel<M, lo, hi, _, l, true, ps...> {
+            using value = argpass::Argpass<type_var::value<Pair<M, KeyAt<ps>>, _>...>;
+        };
+
+        template <class M, unsigned long long lo, unsigned long long hi, class _, unsigned l, bool leaf, unsigned long long ... ps, std::size_t ... Is>
+        struct RangeNext<RangeLevel<M, lo, hi, _, l, leaf, ps...>, std::index_sequence<Is...>> {
+            using Level = RangeLevel<M, lo, hi, _, l, leaf, ps...>;
+            using value = typename RangeLevel<M, lo, hi, _, l + 1, l + 1 == M::depth, Level::children.at[Is]...>::value;
+        };
+
+        template <class M, class K, class _, class Cur = value<Pair<M, KeyAt<K::value>>, _>>
+        struct MapInsertKey {};
+        template <class M, class K, class _>
+        struct MapInsertKey<M, K, _, ctstd::None> :
+            Assign<Pair<M, KeyAt<K::value>>, K, _>,
+            TrieInsert<M, K, std::make_integer_sequence<unsigned, M::depth>, _>
+        {};
+    };
+
+    /// Stores V under the key K of the ordered map M
+    template <class M, class K, class V, class _>
+    struct MapInsert :
+        Assign<containers::Pair<M, containers::ValueAt<containers::MapKey<M, K>::value>>, V, _>,
+        containers::MapInsertKey<M, K, _>
+    {};
+
+    /// The value under the key K of the ordered map M, ctstd::None if there is none
+    template <class M, class K, class _>
+    using MapFind = value<containers::Pair<M, containers::ValueAt<containers::MapKey<M, K>::value>>, _>;
+
+    /// The smallest key of the ordered map M which is not less than K, ctstd::None if there is none
+    /// The key is returned as it was first inserted
+    template <class M, class K, class _>
+    using MapLowerBound = containers::LowerBound<M, containers::MapKey<M, K>::value, _>;
+
+    /// The keys of the ordered map M in [Lo, Hi) as an argpass::Argpass, in increasing order
+    /// It reads the trie nodes which meet the range, one depth at a time, and then one variable per key
+    template <class M, class Lo, class Hi, class _>
+    using map_range = typename containers::RangeLevel<M, containers::MapKey<M, Lo>::value, Hi::value, _, 0, false, 0>::value;
+};
+
+namespace type_var {
+
+    namespace containers {
+        template <class P, class V>
+        struct HeapEntry {
+            using priority = P;
+            using value = V;
+        };
+        template <unsigned i>
+        struct HeapSlot {};
+
+        template <class Q, unsigned i, class _>
+        using heap_slot = type_var::value<Pair<Q, HeapSlot<i>>, _>;
+
+        // the entry E can be above the entry F in the heap
+        template <class E, class F>
+        constexpr bool heap_before = ctstd::to_bool<ctstd::detail::leq_values<typename E::priority, typename F::priority>>;
+
+        template <class Q, unsigned i, class E, class _>
+        struct HeapParentBefore {
+            static constexpr bool value = heap_before<heap_slot<Q, (i - 1) / 2, _>, E>;
+        };
+        template <class Q, class E, class _>
+        struct HeapParentBefore<Q, 0, E, _> {
+            static constexpr bool value = true;
+        };
+
+        // moves the hole at i up until the entry E fits in it
+        template <class Q, unsigned i, class E, class _, bool stop = HeapParentBefore<Q, i, E, _>::value>
+        struct SiftUp : 
+            Assign<Pair<Q, HeapSlot<i>>, heap_slot<Q, (i - 1) / 2, _>, _>,
+            SiftUp<Q, (i - 1) / 2, E, _>
+        {};
+        template <class Q, unsigned i, class E, class _>
+        struct SiftUp<Q, i, E, _, true> : Assign<Pair<Q, HeapSlot<i>>, E, _> {};
+
+        // the smaller child of the slot i of a heap of size n, and whether it goes above the entry E
+        template <class Q, unsigned i, unsigned n, class E, class _, unsigned children = (2 * i + 1 >= n ? 0 : 2 * i + 2 >= n ? 1 : 2)>
+        struct HeapChild {
+            static constexpr bool descend = false;
+        };
+        template <class Q, unsigned i, unsigned n, class E, class _>
+        struct HeapChild<Q, i, n, E, _, 1> {
+            static constexpr unsigned index = 2 * i + 1;
+            using entry = heap_slot<Q, index, _>;
+            static constexpr bool descend = !heap_before<E, entry>;
+        };
+        template <class Q, unsigned i, unsigned n, class E, class _>
+        struct HeapChild<Q, i, n, E, _, 2> {
+            static constexpr bool right = !heap_before<heap_slot<Q, 2 * i + 1, _>, heap_slot<Q, 2 * i + 2, _>>;
+            static constexpr unsigned index = right ? 2 * i + 2 : 2 * i + 1;
+            using entry = heap_slot<Q, index, _>;
+            static constexpr bool descend = !heap_before<E, entry>;
+        };
+
+        // moves the hole at i down until the entry E fits in it
+        template <class Q, unsigned i, unsigned n, class E, class _, class C = HeapChild<Q, i, n, E, _>, bool descend = C::descend>
+        struct SiftDown : Assign<Pair<Q, HeapSlot<i>>, E, _> {};
+        template <class Q, unsigned i, unsigned n, class E, class _, class C>
+        struct SiftDown<Q, i, n, E, _, C, true> :
+            Assign<Pair<Q, HeapSlot<i>>, typename C::entry, _>,
+            SiftDown<Q, C::index, n, E, _>
+        {};
+
+        template <class Q, unsigned n, class _>
+        struct HeapRemoveLast : SiftDown<Q, 0, n, heap_slot<Q, n, _>, _> {};
+        template <class Q, class _>
+        struct HeapRemoveLast<Q, 0, _> {};
+
+        template <class E>
+        struct HeapTop {
+            using priority = typename E::priority;
+            using value = typename E::value;
+        };
+        template <>
+        struct HeapTop<ctstd::None> {
+            using priority = ctstd::None;
+            using value = ctstd::None;
+        };
+
+        // Thunk for the slot 0 of the queue Q, which keeps its last entry after the queue is emptied
+        template <class Q, class _>
+        struct HeapRootSlot {
+            using value = heap_slot<Q, 0, _>;
+        };
+    };
+
+    /// Priority queues: a binary heap, the slot i of the queue Q is the variable Pair<Q, HeapSlot<i>>
+    /// The priorities are numbers of any kind, compared like ctstd::leq, and the smallest one is on top
+    /// Push and PopMin touch O(log n) slots, and Top reads one
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct queue {};
+    /// struct : Push<queue, peano::_3, int, RE> {};
+    /// struct : Push<queue, peano::_1, char, RE> {};
+    /// static_assert(std::is_same_v<Top<queue, RE>, char>);
+    /// ```
+    /// The entries with equal priorities come out in no particular order
+
+    /// The number of entries of the priority queue Q
+    template <class Q, class _>
+    constexpr unsigned heap_size = containers::NumOrZero<value<containers::Pair<Q, containers::Length>, _>>::value;
+
+    /// The value with the smallest priority in the queue Q, and its priority, ctstd::None if Q is empty
+    template <class Q, class _>
+    using Top = typename containers::HeapTop<
+        ctstd::lazy_if<heap_size<Q, _> == 0, ctstd::Identity<ctstd::None>, containers::HeapRootSlot<Q, _>>
+    >::value;
+    template <class Q, class _>
+    using TopPriority = typename containers::HeapTop<
+        ctstd::lazy_if<heap_size<Q, _> == 0, ctstd::Identity<ctstd::None>, containers::HeapRootSlot<Q, _>>
+    >::priority;
+
+    /// Adds the value V with the priority P to the queue Q
+    template <class Q, class P, class V, class _, unsigned n = heap_size<Q, _>>
+    struct Push :
+        containers::SiftUp<Q, n, containers::HeapEntry<P, V>, _>,
+        Assign_v<containers::Pair<Q, containers::Length>, n + 1, _>
+    {};
+
+    /// Removes the top of the queue Q, read it with Top beforehand
+    template <class Q, class _, unsigned n = heap_size<Q, _>>
+    struct PopMin :
+        containers::HeapRemoveLast<Q, (n == 0 ? 0 : n - 1), _>,
+        Assign_v<containers::Pair<Q, containers::Length>, n - 1, _>
+    {
+        static_assert(n > 0, "PopMin from an empty priority queue");
+    };
+};
+
+namespace type_var {
+
+    /// Bitsets: the bits are packed into native words, the word w of the bitset B is the variable
+    /// Pair<B, BitWord<w>> holding a ctstd::Num<unsigned long long>
+    /// A bit costs 1/64 of a variable, and the writes which change nothing are skipped,
+    /// so setting a bit twice doesn't grow the flag chain
+    ///
+    /// Usage:
+    /// ```cpp
+    /// struct visited : PackedBits<1000> {};
+    /// struct : BitSet<visited, 42, RE> {};
+    /// static_assert(std::is_same_v<BitTest<visited, 42, RE>, ctstd::True>);
+    /// ```
+    template <unsigned bits>
+    struct PackedBits {
+        static constexpr unsigned size = bits;
+        static constexpr unsigned words = (bits + 63) / 64;
+    };
+
+    namespace containers {
+        template <unsigned w>
+        struct BitWord {};
+
+        template <class B, unsigned w, class _>
+        constexpr unsigned long long bit_word = NumOrZero<value<Pair<B, BitWord<w>>, _>>::value;
+
+        constexpr unsigned popcount64(unsigned long long word) {
+            unsigned res = 0;
+            for (; word != 0; word &= word - 1) ++res;
+            return res;
+        }
+
+        template <class B, unsigned i>
+        struct BitIndex {
+            static_assert(i < B::size, "the bit is out of the bitset");
+            static constexpr unsigned word = i / 64;
+            static constexpr unsigned long long mask = 1ull << i % 64;
+        };
+
+        template <class B, unsigned w, unsigned long long old, unsigned long long word, class _>
+        struct BitWrite : Assign_v<Pair<B, BitWord<w>>, word, _> {};
+        template <class B, unsigned w, unsigned long long word, class _>
+        struct BitWrite<B, w, word, word, _> {};
+
+        template <class B, class Ws, class _>
+        struct Popcount {};
+        template <class B, unsigned ... ws, class _>
+        struct Popcount<B, std::integer_sequence<unsigned, ws...>, _> {
+            using value = ctstd::Num<(0u + ... + popcount64(bit_word<B, ws, _>))>;
+        };
+    };
+
+    /// Sets the bit i of the bitset B
+    template <class B, unsigned i, class _, unsigned long long old = containers::bit_word<B, containers::BitIndex<B, i>::word, _>>
+    struct BitSet : containers::BitWrite<B, containers::BitIndex<B, i>::word, old, old | containers::BitIndex<B, i>::mask, _> {};
+
+    /// Clears the bit i of the bitset B
+    template <class B, unsigned i, class _, unsigned long long old = containers::bit_word<B, containers::BitIndex<B, i>::word, _>>
+    struct BitClear : containers::BitWrite<B, containers::BitIndex<B, i>::word, old, old & ~containers::BitIndex<B, i>::mask, _> {};
+
+    /// Sets the bits of the mask in the word w of the bitset B, that is the bits 64 * w + j for every bit j of the mask
+    template <class B, unsigned w, unsigned long long mask, class _, unsigned long long old = containers::bit_word<B, w, _>>
+    struct BitSetWord : containers::BitWrite<B, w, old, old | mask, _> {
+        static_assert(w < B::words, "the word is out of the bitset");
+    };
+
+    /// ctstd::True if the bit i of the bitset B is set
+    template <class B, unsigned i, class _>
+    using BitTest = ctstd::conditional_using<
+        (containers::bit_word<B, containers::BitIndex<B, i>::word, _> & containers::BitIndex<B, i>::mask) != 0, 
+        ctstd::True, 
+        ctstd::False
+    >;
+
+    /// The number of the set bits of the bitset B as a ctstd::Num, reading each word once
+    template <class B, class _>
+    using Popcount = typename containers::Popcount<B, std::make_integer_sequence<unsigned, B::words>, _>::value;
+};
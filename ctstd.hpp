@@ -2,6 +2,7 @@
 #include "ctstd_base.hpp"
 #include "type_var.hpp"
 #include "peano.hpp"
+#include "binary.hpp"
 
 namespace ctstd {
     using _0 = peano::Zero;
@@ -21,159 +22,265 @@ namespace ctstd {
     template <unsigned N>
     using Integer = peano::Integer<N>;
 
+    /// Numbers are peano integers, binary integers or native values ctstd::Num
+    /// The arithmetic below treats them as constants, and every other operand as a variable
+    template <class T>
+    using is_number = detail::Or_<peano::is_peano_integer<T>, detail::Or_<binary::is_binary_integer<T>, is_num<T>>>;
+
+    /// The arithmetic on loaded values
+    /// If both operands are peano integers, the result is a peano integer
+    /// If either is a binary integer and neither is a Num, the peano operand is converted and the result is binary
+    /// Otherwise the operation is done natively on their `value`s, and the result is a Num
+    namespace detail {
+        struct PeanoArithmetic {};
+        struct BinaryArithmetic {};
+        struct NativeArithmetic {};
+
+        template <class X, class Y>
+        using arithmetic_of = conditional_using<
+            to_bool<Or_<is_num<X>, is_num<Y>>>, NativeArithmetic,
+            conditional_using<to_bool<Or_<binary::is_binary_integer<X>, binary::is_binary_integer<Y>>>, BinaryArithmetic, PeanoArithmetic>
+        >;
+
+        // The native value of X, a peano or binary integer takes the type of the other operand Y
+        template <class X, class Y, class XisNum = is_num<X>>
+        struct Native { 
+            static constexpr auto value = X::value; 
+        };
+        template <class X, class Y>
+        struct Native<X, Y, False> { 
+            using type = std::remove_const_t<decltype(Y::value)>;
+            static_assert(
+                native_width<X> <= 64 && static_cast<unsigned long long>(static_cast<type>(X::value)) == X::value,
+                "the integer doesn't fit in the native type of the Num it is combined with"
+            );
+            static constexpr type value = X::value; 
+        };
+
+        // The binary integer of a peano or binary X
+        template <class X>
+        using to_binary = lazy_if<to_bool<binary::is_binary_integer<X>>, Identity<X>, binary::detail::IntegerImpl<X::value>>;
+
+        template <class X, class Y, class Kind = arithmetic_of<X, Y>>
+        struct AddValues { using value = peano::add<X, Y>; };
+        template <class X, class Y>
+        struct AddValues<X, Y, BinaryArithmetic> { using value = binary::add<to_binary<X>, to_binary<Y>>; };
+        template <class X, class Y>
+        struct AddValues<X, Y, NativeArithmetic> { using value = Num<Native<X, Y>::value + Native<Y, X>::value>; };
+
+        template <class X, class Y, class Kind = arithmetic_of<X, Y>>
+        struct MultValues { using value = peano::mult<X, Y>; };
+        template <class X, class Y>
+        struct MultValues<X, Y, BinaryArithmetic> { using value = binary::mult<to_binary<X>, to_binary<Y>>; };
+        template <class X, class Y>
+        struct MultValues<X, Y, NativeArithmetic> { using value = Num<Native<X, Y>::value * Native<Y, X>::value>; };
+
+        template <class X, class Y, class Kind = arithmetic_of<X, Y>>
+        struct DivValues { using value = peano::div<X, Y>; };
+        template <class X, class Y>
+        struct DivValues<X, Y, BinaryArithmetic> { using value = binary::div<to_binary<X>, to_binary<Y>>; };
+        template <class X, class Y>
+        struct DivValues<X, Y, NativeArithmetic> { using value = Num<Native<X, Y>::value / Native<Y, X>::value>; };
+
+        template <class X, class Y, class Kind = arithmetic_of<X, Y>>
+        struct RemainderValues { using value = peano::remainder<X, Y>; };
+        template <class X, class Y>
+        struct RemainderValues<X, Y, BinaryArithmetic> { using value = binary::remainder<to_binary<X>, to_binary<Y>>; };
+        template <class X, class Y>
+        struct RemainderValues<X, Y, NativeArithmetic> { using value = Num<Native<X, Y>::value % Native<Y, X>::value>; };
+
+        template <class X, class Y, class Kind = arithmetic_of<X, Y>>
+        struct MinusValues { using value = peano::minus<X, Y>; };
+        template <class X, class Y>
+        struct MinusValues<X, Y, BinaryArithmetic> { using value = binary::minus<to_binary<X>, to_binary<Y>>; };
+        template <class X, class Y>
+        struct MinusValues<X, Y, NativeArithmetic> {
+            static constexpr auto x = Native<X, Y>::value;
+            static constexpr auto y = Native<Y, X>::value;
+            // saturates like peano::minus when that's the only sensible result: an unsigned difference would wrap around,
+            // and a peano operand can't go negative, the signed Nums just subtract
+            static constexpr bool saturates = std::is_unsigned_v<decltype(x - y)> || !to_bool<And_<is_num<X>, is_num<Y>>>;
+            using value = Num<(saturates && x <= y ? decltype(x - y){} : x - y)>;
+        };
+
+        template <class X, class Y, class Kind = arithmetic_of<X, Y>>
+        struct LeqValues { using value = peano::leq<X, Y>; };
+        template <class X, class Y>
+        struct LeqValues<X, Y, BinaryArithmetic> { using value = binary::leq<to_binary<X>, to_binary<Y>>; };
+        template <class X, class Y>
+        struct LeqValues<X, Y, NativeArithmetic> { using value = conditional_using<(Native<X, Y>::value <= Native<Y, X>::value), True, False>; };
+
+        // eq compares any values, numbers are compared by value and everything else by identity
+        template <class X, class Y, class Kind = conditional_using<to_bool<And_<is_number<X>, is_number<Y>>>, arithmetic_of<X, Y>, PeanoArithmetic>>
+        struct EqValues { using value = ctstd::is_same<X, Y>; };
+        template <class X, class Y>
+        struct EqValues<X, Y, BinaryArithmetic> { using value = binary::eq<to_binary<X>, to_binary<Y>>; };
+        template <class X, class Y>
+        struct EqValues<X, Y, NativeArithmetic> { using value = conditional_using<(Native<X, Y>::value == Native<Y, X>::value), True, False>; };
+
+        template <class X, class Y> using add_values = typename AddValues<X, Y>::value;
+        template <class X, class Y> using mult_values = typename MultValues<X, Y>::value;
+        template <class X, class Y> using div_values = typename DivValues<X, Y>::value;
+        template <class X, class Y> using remainder_values = typename RemainderValues<X, Y>::value;
+        template <class X, class Y> using minus_values = typename MinusValues<X, Y>::value;
+        template <class X, class Y> using leq_values = typename LeqValues<X, Y>::value;
+        template <class X, class Y> using eq_values = typename EqValues<X, Y>::value;
+    };
+
 
     namespace detail {
         template <class T, class U, class TisRV, class UisRV, class _>
         struct AddImpl : _ {
-            using value = peano::add<type_var::value<T, _>, type_var::value<U, _>>;
+            using value = detail::add_values<type_var::value<T, _>, type_var::value<U, _>>;
         };
 
         template <class T, class U, class _>
         struct AddImpl<T, U, ctstd::False, ctstd::True, _> : _ {
-            using value = peano::add<type_var::value<T, _>, U>;
+            using value = detail::add_values<type_var::value<T, _>, U>;
         };
         template <class T, class U, class _>
         struct AddImpl<T, U, ctstd::True, ctstd::False, _> : _ {
-            using value = peano::add<T, type_var::value<U, _>>;
+            using value = detail::add_values<T, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct AddImpl<T, U, ctstd::True, ctstd::True, _> : _ {
-            using value = peano::add<T, U>;
+            using value = detail::add_values<T, U>;
         };
     };
 
     template <class T, class U, class _>
-    using add = typename detail::AddImpl<T, U, peano::is_peano_integer<T>, peano::is_peano_integer<U>, _>::value;
+    using add = typename detail::AddImpl<T, U, is_number<T>, is_number<U>, _>::value;
 
     namespace detail {
         template <class T, class U, class TisRV, class UisRV, class _>
         struct MultImpl : _ {
-            using value = peano::mult<type_var::value<T, _>, type_var::value<U, _>>;
+            using value = detail::mult_values<type_var::value<T, _>, type_var::value<U, _>>;
         };
 
         template <class T, class U, class _>
         struct MultImpl<T, U, ctstd::False, ctstd::True, _> : _ {
-            using value = peano::mult<type_var::value<T, _>, U>;
+            using value = detail::mult_values<type_var::value<T, _>, U>;
         };
         template <class T, class U, class _>
         struct MultImpl<T, U, ctstd::True, ctstd::False, _> : _ {
-            using value = peano::mult<T, type_var::value<U, _>>;
+            using value = detail::mult_values<T, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct MultImpl<T, U, ctstd::True, ctstd::True, _> : _ {
-            using value = peano::mult<T, U>;
+            using value = detail::mult_values<T, U>;
         };
     };
     template <class T, class U, class _>
-    using mult = typename detail::MultImpl<T, U, peano::is_peano_integer<T>, peano::is_peano_integer<U>, _>::value;
+    using mult = typename detail::MultImpl<T, U, is_number<T>, is_number<U>, _>::value;
 
     namespace detail {
         template <class T, class U, class TisRV, class UisRV, class _>
         struct DivImpl : _ {
-            using value = peano::div<type_var::value<T, _>, type_var::value<U, _>>;
+            using value = detail::div_values<type_var::value<T, _>, type_var::value<U, _>>;
         };
 
         template <class T, class U, class _>
         struct DivImpl<T, U, ctstd::False, ctstd::True, _> : _ {
-            using value = peano::div<type_var::value<T, _>, U>;
+            using value = detail::div_values<type_var::value<T, _>, U>;
         };
         template <class T, class U, class _>
         struct DivImpl<T, U, ctstd::True, ctstd::False, _> : _ {
-            using value = peano::div<T, type_var::value<U, _>>;
+            using value = detail::div_values<T, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct DivImpl<T, U, ctstd::True, ctstd::True, _> : _ {
-            using value = peano::div<T, U>;
+            using value = detail::div_values<T, U>;
         };
     };
     template <class T, class U, class _>
-    using divide = typename detail::DivImpl<T, U, peano::is_peano_integer<T>, peano::is_peano_integer<U>, _>::value;
+    using divide = typename detail::DivImpl<T, U, is_number<T>, is_number<U>, _>::value;
 
     namespace detail {
         template <class T, class U, class TisRV, class UisRV, class _>
         struct RemainderImpl : _ {
-            using value = peano::remainder<type_var::value<T, _>, type_var::value<U, _>>;
+            using value = detail::remainder_values<type_var::value<T, _>, type_var::value<U, _>>;
         };
 
         template <class T, class U, class _>
         struct RemainderImpl<T, U, ctstd::False, ctstd::True, _> : _ {
-            using value = peano::remainder<type_var::value<T, _>, U>;
+            using value = detail::remainder_values<type_var::value<T, _>, U>;
         };
         template <class T, class U, class _>
         struct RemainderImpl<T, U, ctstd::True, ctstd::False, _> : _ {
-            using value = peano::remainder<T, type_var::value<U, _>>;
+            using value = detail::remainder_values<T, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct RemainderImpl<T, U, ctstd::True, ctstd::True, _> : _ {
-            using value = peano::remainder<T, U>;
+            using value = detail::remainder_values<T, U>;
         };
     };
     template <class T, class U, class _>
-    using remainder = typename detail::RemainderImpl<T, U, peano::is_peano_integer<T>, peano::is_peano_integer<U>, _>::value;
+    using remainder = typename detail::RemainderImpl<T, U, is_number<T>, is_number<U>, _>::value;
 
     namespace detail {
         template <class T, class U, class TisRV, class UisRV, class _>
         struct MinusImpl : _ {
-            using value = peano::minus<type_var::value<T, _>, type_var::value<U, _>>;
+            using value = detail::minus_values<type_var::value<T, _>, type_var::value<U, _>>;
         };
 
         template <class T, class U, class _>
         struct MinusImpl<T, U, ctstd::False, ctstd::True, _> : _ {
-            using value = peano::minus<type_var::value<T, _>, U>;
+            using value = detail::minus_values<type_var::value<T, _>, U>;
         };
         template <class T, class U, class _>
         struct MinusImpl<T, U, ctstd::True, ctstd::False, _> : _ {
-            using value = peano::minus<T, type_var::value<U, _>>;
+            using value = detail::minus_values<T, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct MinusImpl<T, U, ctstd::True, ctstd::True, _> : _ {
-            using value = peano::minus<T, U>;
+            using value = detail::minus_values<T, U>;
         };
     };
+    /// T - U, or zero if U > T, for every kind of numbers, Num included
     template <class T, class U, class _>
-    using minus = typename detail::MinusImpl<T, U, peano::is_peano_integer<T>, peano::is_peano_integer<U>, _>::value;   
+    using minus = typename detail::MinusImpl<T, U, is_number<T>, is_number<U>, _>::value;   
 
     namespace detail {
         template <class T, class U, class TisRV, class UisRV, class _>
         struct LeqImpl : _ {
-            using value = peano::leq<type_var::value<T, _>, type_var::value<U, _>>;
+            using value = detail::leq_values<type_var::value<T, _>, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct LeqImpl<T, U, ctstd::False, ctstd::True, _> : _ {
-            using value = peano::leq<type_var::value<T, _>, U>;
+            using value = detail::leq_values<type_var::value<T, _>, U>;
         };
         template <class T, class U, class _>
         struct LeqImpl<T, U, ctstd::True, ctstd::False, _> : _ {
-            using value = peano::leq<T, type_var::value<U, _>>;
+            using value = detail::leq_values<T, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct LeqImpl<T, U, ctstd::True, ctstd::True, _> : _ {
-            using value = peano::leq<T, U>;
+            using value = detail::leq_values<T, U>;
         };
     };
     template <class T, class U, class _>
-    using leq = typename detail::LeqImpl<T, U, peano::is_peano_integer<T>, peano::is_peano_integer<U>, _>::value;
+    using leq = typename detail::LeqImpl<T, U, is_number<T>, is_number<U>, _>::value;
 
     namespace detail {
         template <class T, class U, class TisRV, class UisRV, class _>
         struct EqImpl : _ {
-            using value = ctstd::is_same<type_var::value<T, _>, type_var::value<U, _>>;
+            using value = detail::eq_values<type_var::value<T, _>, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct EqImpl<T, U, ctstd::False, ctstd::True, _> : _ {
-            using value = ctstd::is_same<type_var::value<T, _>, U>;
+            using value = detail::eq_values<type_var::value<T, _>, U>;
         };
         template <class T, class U, class _>
         struct EqImpl<T, U, ctstd::True, ctstd::False, _> : _ {
-            using value = ctstd::is_same<T, type_var::value<U, _>>;
+            using value = detail::eq_values<T, type_var::value<U, _>>;
         };
         template <class T, class U, class _>
         struct EqImpl<T, U, ctstd::True, ctstd::True, _>  : _{
-            using value = ctstd::is_same<T, U>;
+            using value = detail::eq_values<T, U>;
         };
     };
     template <class T, class U, class _>
-    using eq = typename detail::EqImpl<T, U, peano::is_peano_integer<T>, peano::is_peano_integer<U>, _>::value;
+    using eq = typename detail::EqImpl<T, U, is_number<T>, is_number<U>, _>::value;
 
 
     namespace detail {
@@ -252,3 +359,369 @@ namespace ctstd {
     template <class T, class U, class _>
     using Xor = typename detail::XorImpl<T, U, is_boolean<T>, is_boolean<U>, _>::value;
 };
+
+
+/// Expression trees
+/// 
+/// The front ends above load their variable operands at every node,
+/// so `eq<remainder<a, _2, RE>, _0, RE>` and its siblings walk the flag chain of `a` over and over.
+/// `evaluate<E, _>` collects the distinct variables of the tree E, loads each of them once,
+/// then evaluates the tree on the loaded values.
+/// 
+/// Example:
+/// ```cpp
+/// // a = 3 * a + 1, reading a once
+/// run_line : Assign<a, evaluate<expr::add<expr::mult<a, _3>, _1>, RE>, RE> {};
+/// ```
+namespace ctstd {
+    namespace detail { struct IsExpression {}; };
+    template <class T>
+    using is_expression = ctstd::is_base_of<detail::IsExpression, T>;
+
+    /// Expression nodes, mirroring the front ends without the trailing `_`
+    /// The member `apply` is the operation on plain values
+    namespace expr {
+        template <class T, class U> struct add : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::add_values<X, Y>;
+        };
+        template <class T, class U> struct mult : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::mult_values<X, Y>;
+        };
+        template <class T, class U> struct divide : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::div_values<X, Y>;
+        };
+        template <class T, class U> struct remainder : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::remainder_values<X, Y>;
+        };
+        template <class T, class U> struct minus : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::minus_values<X, Y>;
+        };
+        template <class T, class U> struct leq : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::leq_values<X, Y>;
+        };
+        template <class T, class U> struct eq : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::eq_values<X, Y>;
+        };
+        template <class T> struct Not : ctstd::detail::IsExpression {
+            template <class X> using apply = ctstd::detail::Not_<X>;
+        };
+        template <class T, class U> struct And : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::And_<X, Y>;
+        };
+        template <class T, class U> struct Or : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::Or_<X, Y>;
+        };
+        template <class T, class U> struct Xor : ctstd::detail::IsExpression {
+            template <class X, class Y> using apply = ctstd::detail::Xor_<X, Y>;
+        };
+    };
+
+    namespace detail {
+        // The leaves which are neither numbers nor booleans are variables
+        template <class T>
+        using is_constant_leaf = Or_<is_number<T>, is_boolean<T>>;
+
+        // Collects the distinct variables of an expression tree into Vars = Argpass<...>
+        template <class Vars, class E, class IsExpr = is_expression<E>, class IsConst = is_constant_leaf<E>>
+        struct CollectVars {
+            using value = Vars;
+        };
+        template <class ... Vars, class E>
+        struct CollectVars<argpass::Argpass<Vars...>, E, False, False> {
+            using value = ctstd::conditional_using<
+                (std::is_same_v<E, Vars> || ...),
+                argpass::Argpass<Vars...>,
+                argpass::Argpass<Vars..., E>
+            >;
+        };
+
+        template <class Vars, class ... Es>
+        struct CollectVarsList {
+            using value = Vars;
+        };
+        template <class Vars, class E, class ... Es>
+        struct CollectVarsList<Vars, E, Es...> {
+            using value = typename CollectVarsList<typename CollectVars<Vars, E>::value, Es...>::value;
+        };
+
+        template <class Vars, template <class ...> class Node, class ... Ts>
+        struct CollectVars<Vars, Node<Ts...>, True, False> {
+            using value = typename CollectVarsList<Vars, Ts...>::value;
+        };
+
+        // The environment maps each variable to its value, lookup is done by overload resolution
+        template <class T>
+        struct Boxed {
+            using value = T;
+        };
+        template <class Var, class Val>
+        struct Binding {};
+
+        template <class Var, class Val>
+        Boxed<Val> lookup(Binding<Var, Val>*);
+
+        template <class Vars, class _>
+        struct Env {};
+        template <class ... Vars, class _>
+        struct Env<argpass::Argpass<Vars...>, _> : Binding<Vars, type_var::value<Vars, _>>... {};
+
+        template <class E, class Env, class IsExpr = is_expression<E>, class IsConst = is_constant_leaf<E>>
+        struct Eval {
+            using value = typename decltype(detail::lookup<E>(static_cast<Env*>(nullptr)))::value;
+        };
+        template <class E, class Env>
+        struct Eval<E, Env, False, True> {
+            using value = E;
+        };
+        template <template <class ...> class Node, class ... Ts, class Env>
+        struct Eval<Node<Ts...>, Env, True, False> {
+            using value = typename Node<Ts...>::template apply<typename Eval<Ts, Env>::value...>;
+        };
+
+        template <class E, class _>
+        struct EvaluateImpl : _ {
+            using value = typename Eval<
+                E, 
+                Env<typename CollectVars<argpass::Argpass<>, E>::value, _>
+            >::value;
+        };
+    };
+
+    /// Evaluates the expression tree E, reading each of its variables exactly once
+    /// Leaves of E are numbers, booleans or variables, nodes are taken from ctstd::expr
+    template <class E, class _>
+    using evaluate = typename detail::EvaluateImpl<E, _>::value;
+};
+
+/// Bridge to ordinary constexpr functions
+/// 
+/// Arbitrary numeric logic, like hashes, bit tricks or primality tests, is very slow to compile
+/// when written as template recursion. apply_constexpr runs it in the constant evaluator instead.
+namespace ctstd {
+    namespace detail {
+        // booleans become bool, numbers their native value
+        template <class X, class IsBool = is_boolean<X>>
+        struct ToNative {
+            static_assert(native_width<X> <= 64, "the binary integer doesn't fit in 64 bits");
+            static constexpr auto value = X::value;
+        };
+        template <class X>
+        struct ToNative<X, True> {
+            static constexpr bool value = to_bool<X>;
+        };
+
+        template <auto v>
+        struct PeanoOf {
+            using value = peano::Integer<v>;
+        };
+        template <auto v>
+        struct BinaryOf {
+            static_assert(std::cmp_greater_equal(v, 0), "a binary integer can't be negative");
+            using value = binary::Integer<v>;
+        };
+
+        // the kind of the result: Num if an operand is a Num, binary if an operand is binary, and peano otherwise
+        template <class ... Args>
+        using result_arithmetic_of = conditional_using<
+            (std::is_same_v<is_num<Args>, True> || ...), NativeArithmetic,
+            conditional_using<(std::is_same_v<binary::is_binary_integer<Args>, True> || ...), BinaryArithmetic, PeanoArithmetic>
+        >;
+
+        // bool becomes a boolean, integers a number of the given kind
+        template <auto v, class Kind, bool IsBool = std::is_same_v<std::remove_cv_t<decltype(v)>, bool>>
+        struct FromNative {
+            using value = typename PeanoOf<v>::value;
+        };
+        template <auto v, class Kind>
+        struct FromNative<v, Kind, true> {
+            using value = conditional_using<v, True, False>;
+        };
+        template <auto v>
+        struct FromNative<v, NativeArithmetic, false> {
+            using value = Num<v>;
+        };
+        template <auto v>
+        struct FromNative<v, BinaryArithmetic, false> {
+            using value = typename BinaryOf<v>::value;
+        };
+
+        template <class F, class Args, class _>
+        struct ApplyConstexprImpl {};
+        template <class F, class ... Args, class _>
+        struct ApplyConstexprImpl<F, argpass::Argpass<Args...>, _> : _ {
+            using env = Env<typename CollectVarsList<argpass::Argpass<>, Args...>::value, _>;
+
+            static constexpr auto result = F{}(ToNative<typename Eval<Args, env>::value>::value...);
+            using value = typename FromNative<result, result_arithmetic_of<typename Eval<Args, env>::value...>>::value;
+        };
+
+        // splits the trailing _ off the arguments
+        template <class F, class Args, class ... Rest>
+        struct ApplyConstexprSplit {};
+        template <class F, class ... Args, class _>
+        struct ApplyConstexprSplit<F, argpass::Argpass<Args...>, _> {
+            using value = typename ApplyConstexprImpl<F, argpass::Argpass<Args...>, _>::value;
+        };
+        template <class F, class ... Args, class T, class U, class ... Rest>
+        struct ApplyConstexprSplit<F, argpass::Argpass<Args...>, T, U, Rest...> {
+            using value = typename ApplyConstexprSplit<F, argpass::Argpass<Args..., T>, U, Rest...>::value;
+        };
+    };
+
+    /// Calls the constexpr callable F on the native values of the operands
+    /// 
+    /// Template parameters:
+    /// - F: A default-constructible type with a constexpr operator(), like a captureless lambda
+    /// - Args...: Numbers, booleans, variables holding them, or expressions from ctstd::expr
+    ///   Each distinct variable is read once
+    /// - _: Unique lambda type decltype([](){}), as the last argument
+    /// 
+    /// Returns: ctstd::True/False if F returns bool, a number otherwise
+    /// The number is a Num if any operand is a Num, a binary integer if any operand is binary, and a peano integer otherwise
+    /// Binary operands must fit in 64 bits
+    /// 
+    /// Example:
+    /// ```cpp
+    /// using IsPrime = decltype([](unsigned n) {
+    ///     if (n < 2) return false;
+    ///     for (unsigned d = 2; d * d <= n; ++d) if (n % d == 0) return false;
+    ///     return true;
+    /// });
+    /// run_line : Assign<c, apply_constexpr<IsPrime, a, RE>, RE> {};
+    /// ```
+    template <class F, class ... Args>
+    using apply_constexpr = typename detail::ApplyConstexprSplit<F, argpass::Argpass<>, Args...>::value;
+};
+
+/// Reductions over argpass::Argpass
+/// 
+/// Nesting And<And<...>> or add<add<...>> costs one front end per element and depth linear in N
+/// The reductions evaluate all the operands at once, with fold expressions in constant depth
+namespace ctstd {
+    namespace detail {
+        // The values of the operands Args, each distinct variable is read once
+        template <class Args, class _>
+        struct ValuesOf {};
+        template <class ... Args, class _>
+        struct ValuesOf<argpass::Argpass<Args...>, _> {
+            using env = Env<typename CollectVarsList<argpass::Argpass<>, Args...>::value, _>;
+            using value = argpass::Argpass<typename Eval<Args, env>::value...>;
+        };
+
+        // Folding over Acc applies the operations on values pairwise, without nesting templates
+        template <class X>
+        struct Acc {
+            using value = X;
+        };
+        template <class X, class Y>
+        Acc<add_values<X, Y>> operator+(Acc<X>, Acc<Y>);
+        template <class X, class Y>
+        Acc<mult_values<X, Y>> operator*(Acc<X>, Acc<Y>);
+        // max
+        template <class X, class Y>
+        Acc<conditional_using<to_bool<leq_values<Y, X>>, X, Y>> operator|(Acc<X>, Acc<Y>);
+
+        // Num dominates binary, binary dominates peano, as in the binary operations
+        template <class ... Vs>
+        using reduction_kind = conditional_using<
+            (to_bool<is_num<Vs>> || ...), NativeArithmetic,
+            conditional_using<(to_bool<binary::is_binary_integer<Vs>> || ...), BinaryArithmetic, PeanoArithmetic>
+        >;
+
+        template <class Vals>
+        struct AllOf {};
+        template <class ... Vs>
+        struct AllOf<argpass::Argpass<Vs...>> {
+            using value = conditional_using<(to_bool<Vs> && ...), True, False>;
+        };
+
+        template <class Vals>
+        struct AnyOf {};
+        template <class ... Vs>
+        struct AnyOf<argpass::Argpass<Vs...>> {
+            using value = conditional_using<(to_bool<Vs> || ...), True, False>;
+        };
+
+        template <class Vals>
+        struct CountTrue {};
+        template <class ... Vs>
+        struct CountTrue<argpass::Argpass<Vs...>> {
+            using value = peano::Integer<(0u + ... + unsigned(to_bool<Vs>))>;
+        };
+
+        // peano integers are summed natively, the rest through the binary operations
+        template <class Vals, class Kind>
+        struct SumOf {};
+        template <class ... Vs>
+        struct SumOf<argpass::Argpass<Vs...>, PeanoArithmetic> {
+            using value = peano::Integer<(0u + ... + Vs::value)>;
+        };
+        template <class ... Vs, class Kind>
+        struct SumOf<argpass::Argpass<Vs...>, Kind> {
+            using value = typename decltype((Acc<peano::_0>{} + ... + Acc<Vs>{}))::value;
+        };
+        template <class Vals>
+        struct Sum {};
+        template <class ... Vs>
+        struct Sum<argpass::Argpass<Vs...>> {
+            using value = typename SumOf<argpass::Argpass<Vs...>, reduction_kind<Vs...>>::value;
+        };
+
+        template <class Vals, class Kind>
+        struct ProductOf {};
+        template <class ... Vs>
+        struct ProductOf<argpass::Argpass<Vs...>, PeanoArithmetic> {
+            using value = peano::Integer<(1u * ... * Vs::value)>;
+        };
+        template <class ... Vs, class Kind>
+        struct ProductOf<argpass::Argpass<Vs...>, Kind> {
+            using value = typename decltype((Acc<peano::_1>{} * ... * Acc<Vs>{}))::value;
+        };
+        template <class Vals>
+        struct Product {};
+        template <class ... Vs>
+        struct Product<argpass::Argpass<Vs...>> {
+            using value = typename ProductOf<argpass::Argpass<Vs...>, reduction_kind<Vs...>>::value;
+        };
+
+        template <class Vals>
+        struct MaxOf {};
+        template <class ... Vs>
+        struct MaxOf<argpass::Argpass<Vs...>> {
+            static_assert(sizeof...(Vs) > 0, "max_of of an empty Argpass");
+            using value = typename decltype((Acc<Vs>{} | ...))::value;
+        };
+
+        template <template <class> class Reduction, class Args, class _>
+        struct ReduceImpl : _ {
+            using value = typename Reduction<typename ValuesOf<Args, _>::value>::value;
+        };
+    };
+
+    /// Template parameters:
+    /// - Args: argpass::Argpass of booleans, variables holding them, or expressions from ctstd::expr
+    /// - _: Unique lambda type decltype([](){})
+    /// 
+    /// Returns: ctstd::True/False, all_of of nothing is True and any_of of nothing is False
+    template <class Args, class _>
+    using all_of = typename detail::ReduceImpl<detail::AllOf, Args, _>::value;
+    template <class Args, class _>
+    using any_of = typename detail::ReduceImpl<detail::AnyOf, Args, _>::value;
+    /// Returns: the number of True operands, as a peano integer
+    template <class Args, class _>
+    using count_true = typename detail::ReduceImpl<detail::CountTrue, Args, _>::value;
+
+    /// Template parameters:
+    /// - Args: argpass::Argpass of numbers, variables holding them, or expressions from ctstd::expr
+    /// - _: Unique lambda type decltype([](){})
+    /// 
+    /// Returns: the sum, the product or the largest operand
+    /// The result is a Num if any operand is a Num, else binary if any operand is binary, else peano
+    /// max_of returns the largest operand as it is, and needs at least one
+    template <class Args, class _>
+    using sum = typename detail::ReduceImpl<detail::Sum, Args, _>::value;
+    template <class Args, class _>
+    using product = typename detail::ReduceImpl<detail::Product, Args, _>::value;
+    template <class Args, class _>
+    using max_of = typename detail::ReduceImpl<detail::MaxOf, Args, _>::value;
+};
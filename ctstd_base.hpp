@@ -1,4 +1,5 @@
 #pragma once
+#include <type_traits>
 #include <utility>
 /// GENERAL WARNINGS :
 /// std=c++20 REQUIRED
@@ -6,6 +7,14 @@ static_assert(__cplusplus >= 202002L);
 /// expect frequent random crashes
 /// Do not forget Wno-return-type & Wno-non-template-friend
 
+/// The basic predicates can use the compiler intrinsics __is_same, __is_base_of and __type_pack_element
+/// Clang uses them where they are available, GCC doesn't by default because they don't pay off there (see DEVLOG.md)
+/// Define CTSTD_INTRINSICS to force them on, CTSTD_NO_INTRINSICS to force the portable implementations
+#if defined(__has_builtin) && !defined(CTSTD_NO_INTRINSICS) && (defined(__clang__) || defined(CTSTD_INTRINSICS))
+#define CTSTD_HAS_BUILTIN(x) __has_builtin(x)
+#else
+#define CTSTD_HAS_BUILTIN(x) 0
+#endif
 
 
 
@@ -18,6 +27,30 @@ namespace ctstd {
     struct False : detail::IsBoolean {};
 
     
+    namespace detail {
+        template <bool cond, class T_true, class T_false>
+        struct conditional_using_impl {
+            using value = None;
+        };
+
+        template <class T, class U>
+        struct conditional_using_impl<true, T, U> {
+            using value = T;
+        };
+        template <class T, class U>
+        struct conditional_using_impl<false, T, U> {
+            using value = U;
+        }; 
+    };
+
+#if CTSTD_HAS_BUILTIN(__type_pack_element)
+    template <bool v, class T_true, class T_false>
+    using conditional_using = __type_pack_element<v ? 0 : 1, T_true, T_false>;
+#else
+    template <bool v, class T_true, class T_false>
+    using conditional_using = typename detail::conditional_using_impl<v, T_true, T_false>::value;
+#endif
+
     namespace detail {
         template <class T, class U>
         struct is_same_impl {
@@ -28,8 +61,13 @@ namespace ctstd {
             using value = ctstd::True;
         };
     };
+#if CTSTD_HAS_BUILTIN(__is_same)
+    template <class T, class U>
+    using is_same = conditional_using<__is_same(T, U), True, False>;
+#else
     template <class T, class U>
     using is_same = typename detail::is_same_impl<T, U>::value;
+#endif
 
     namespace detail {
         template<typename B>
@@ -43,8 +81,29 @@ namespace ctstd {
         auto test_is_base_of(...) -> True; // private or ambiguous base
     }
  
+    /// True when Base and Derived are the same class or Derived is a complete class derived from Base,
+    /// private and ambiguous bases included, False for references and non-class types
+    /// Like every template, the answer is fixed the first time it's asked: a class tested while only declared
+    /// stays unrelated to its bases after it's defined, with and without the intrinsics
+#if CTSTD_HAS_BUILTIN(__is_base_of)
+    namespace detail {
+        // __is_base_of is a hard error when Derived is incomplete, the portable test gives False then
+        // variable names are often only declared, so they are tested too
+        template <class Base, class Derived>
+        constexpr bool builtin_is_base_of = false;
+        template <class Base, class Derived>
+        requires (requires { sizeof(Derived); } || std::is_same_v<Base, Derived>)
+        constexpr bool builtin_is_base_of<Base, Derived> = __is_base_of(Base, Derived);
+    }
+
     template<typename Base, typename Derived>
-    using is_base_of = decltype(detail::test_is_base_of<Base, Derived>(0));
+    using is_base_of = conditional_using<detail::builtin_is_base_of<Base, Derived>, True, False>;
+#else
+    // the fallback of test_is_base_of also catches the references, whose pointers don't exist
+    template<typename Base, typename Derived>
+    using is_base_of = conditional_using<std::is_class_v<Base> && std::is_class_v<Derived>,
+        decltype(detail::test_is_base_of<Base, Derived>(0)), False>;
+#endif
 
 
 
@@ -53,6 +112,23 @@ namespace ctstd {
     using is_boolean = ctstd::is_base_of<detail::IsBoolean, T>;
 
 
+    namespace detail {  struct IsNum {};  };
+    /// Native compile-time value, stored as a non-type template parameter
+    /// The arithmetic on Num is done by the compiler, instead of by template recursion
+    template <auto V>
+    struct Num : detail::IsNum {
+        static constexpr auto value = V;
+    };
+    template <class T>
+    using is_num = ctstd::is_base_of<detail::IsNum, T>;
+
+    namespace detail {
+        // the number of bits of a binary integer, specialized in binary.hpp, the other numbers always fit in 64 bits
+        template <class X>
+        constexpr unsigned native_width = 0;
+    };
+
+
     namespace detail {
         template <class T>
         struct ToBoolImpl {
@@ -122,24 +198,23 @@ namespace ctstd {
         using Xor_ = typename ctstd::detail::XorImpl_<T, U>::value;
     };
 
-    namespace detail {
-        template <bool cond, class T_true, class T_false>
-        struct conditional_using_impl {
-            using value = None;
-        };
-
-        template <class T, class U>
-        struct conditional_using_impl<true, T, U> {
-            using value = T;
-        };
-        template <class T, class U>
-        struct conditional_using_impl<false, T, U> {
-            using value = U;
-        }; 
+    /// Thunk returning T, for the branches of lazy_if which are already formed types
+    template <class T>
+    struct Identity {
+        using value = T;
     };
 
-    template <bool v, class T_true, class T_false>
-    using conditional_using = typename detail::conditional_using_impl<v, T_true, T_false>::value;
+    /// Lazy conditional: the branches are thunks, that is, types with a member `value`
+    /// Only the `value` of the chosen branch is instantiated, so the other branch may be
+    /// expensive, infinitely recursive or even ill-formed
+    /// 
+    /// Example:
+    /// ```cpp
+    /// // Div<A, B> is never instantiated when A < B
+    /// using value = lazy_if<(A::value < B::value), Identity<Zero>, Div<A, B>>;
+    /// ```
+    template <bool v, class Thunk_true, class Thunk_false>
+    using lazy_if = typename conditional_using<v, Thunk_true, Thunk_false>::value;
 };
 
 
@@ -250,4 +325,504 @@ namespace argpass {
     template <class Args> using last = pass_args<detail::pack_last, Args>;
     template <class Args> using first = pass_args<detail::pack_first, Args>;
     template <class Args> using tail = pass_args<detail::pack_tail, Args>;
-};
\ No newline at end of file
+
+
+    /// Indexing and slicing in constant depth
+    /// Element K used to be reachable only by peeling tail K times, which made index loops quadratic
+    namespace detail {
+#if CTSTD_HAS_BUILTIN(__type_pack_element)
+        constexpr bool builtin_pack_at = true;
+        template <std::size_t K, class ... Ts>
+        using pack_at = __type_pack_element<K, Ts...>;
+#elif defined(__cpp_pack_indexing)
+        constexpr bool builtin_pack_at = true;
+        template <std::size_t K, class ... Ts>
+        using pack_at = Ts...[K];
+#else
+        constexpr bool builtin_pack_at = false;
+        // Each element becomes a base tagged with its index, and overload resolution picks the Kth base
+        // A lookup still walks all the bases, so it's O(n) instead of O(1), still in constant depth
+        template <std::size_t I, class T>
+        struct Indexed {
+            using value = T;
+        };
+        template <class Is, class ... Ts>
+        struct IndexedPack {};
+        template <std::size_t ... Is, class ... Ts>
+        struct IndexedPack<std::index_sequence<Is...>, Ts...> : Indexed<Is, Ts>... {};
+
+        template <std::size_t K, class T>
+        Indexed<K, T> select(Indexed<K, T>*);
+
+        template <std::size_t K, class ... Ts>
+        using pack_at = typename decltype(detail::select<K>(
+            static_cast<IndexedPack<std::index_sequence_for<Ts...>, Ts...>*>(nullptr)
+        ))::value;
+#endif
+
+        template <class Args, std::size_t K>
+        struct At {};
+        template <class ... Ts, std::size_t K>
+        struct At<Argpass<Ts...>, K> {
+            static_assert(K < sizeof...(Ts), "argpass::at index out of range");
+            using value = pack_at<K, Ts...>;
+        };
+
+        // The first N parameters swallow the dropped elements, the rest are deduced
+        template <class T>
+        struct Type {};
+        template <std::size_t>
+        using Ignored = const volatile void*;
+
+        template <class Is>
+        struct Dropper {};
+        template <std::size_t ... Is>
+        struct Dropper<std::index_sequence<Is...>> {
+            template <class ... Ts>
+            static Argpass<Ts...> drop(Ignored<Is>..., Type<Ts>*...);
+        };
+
+        template <class Args, std::size_t N>
+        struct Drop {};
+        template <class ... Ts, std::size_t N>
+        struct Drop<Argpass<Ts...>, N> {
+            static_assert(N <= sizeof...(Ts), "argpass::drop of more elements than there are");
+            using value = decltype(Dropper<std::make_index_sequence<N>>::drop(static_cast<Type<Ts>*>(nullptr)...));
+        };
+
+        template <class Args, class Is>
+        struct Take {};
+        template <class ... Ts, std::size_t ... Is>
+        struct Take<Argpass<Ts...>, std::index_sequence<Is...>> {
+            static_assert(sizeof...(Is) <= sizeof...(Ts), "argpass::take of more elements than there are");
+            using value = Argpass<pack_at<Is, Ts...>...>;
+        };
+    };
+
+    /// The number of elements of Args
+    template <class Args>
+    constexpr std::size_t size = Args::size;
+    /// The Kth element of Args, counting from 0
+    template <class Args, std::size_t K>
+    using at = typename detail::At<Args, K>::value;
+    /// The first N elements of Args
+    /// O(N) with the builtins, otherwise every element is a lookup over Args, O(N * size<Args>)
+    template <class Args, std::size_t N>
+    using take = typename detail::Take<Args, std::make_index_sequence<N>>::value;
+    /// Args without its first N elements
+    template <class Args, std::size_t N>
+    using drop = typename detail::Drop<Args, N>::value;
+    /// The elements [Begin, End) of Args
+    template <class Args, std::size_t Begin, std::size_t End>
+    using slice = take<drop<Args, Begin>, End - Begin>;
+
+
+    /// Multi-way concatenation in constant depth with the builtins, and O(log k) depth for k packs without them
+    /// Nesting concat costs one Concatter per pack, and a recursion level per pack
+    namespace detail {
+        // With the builtin pack indexing, every element of the result is looked up by its pack
+        // and its index in that pack, which is linear in the size of the result
+        template <std::size_t Total>
+        struct Locations {
+            std::size_t pack[Total + 1];
+            std::size_t index[Total + 1];
+        };
+
+        // a loop, the fold expression (0 + ... + sizes) is nested as deep as there are packs
+        template <std::size_t ... sizes>
+        constexpr std::size_t total_size() {
+            std::size_t pack_sizes[] = {sizes..., 0};
+            std::size_t res = 0;
+            for (std::size_t size : pack_sizes) {
+                res += size;
+            }
+            return res;
+        }
+
+        template <std::size_t ... sizes>
+        constexpr auto locate() {
+            Locations<detail::total_size<sizes...>()> res{};
+            std::size_t pack_sizes[] = {sizes..., 0};
+            std::size_t j = 0;
+            for (std::size_t p = 0; p < sizeof...(sizes); ++p) {
+                for (std::size_t k = 0; k < pack_sizes[p]; ++k, ++j) {
+                    res.pack[j] = p;
+                    res.index[j] = k;
+                }
+            }
+            return res;
+        }
+
+        template <class Js, class ... Packs>
+        struct ConcatByIndex {};
+        template <std::size_t ... Js, class ... Packs>
+        struct ConcatByIndex<std::index_sequence<Js...>, Packs...> {
+            static constexpr auto locations = detail::locate<Packs::size...>();
+            using value = Argpass<typename At<pack_at<locations.pack[Js], Packs...>, locations.index[Js]>::value...>;
+        };
+
+        // Without it, each lookup costs a pass over all the packs, so the packs are merged like a binary counter:
+        // a block holds 2^r consecutive packs, and a new pack carries into the blocks of equal size,
+        // so the merges form a balanced tree, O(n log k) for n elements in k packs, and O(log k) deep
+        // The packs are pushed by a fold, which has no depth, onto a nested class of the counter:
+        // operators on the counter itself would make argument dependent lookup walk all the elements at each push
+        // Merge<Older, Newer> joins two blocks, make_set uses the same counter with set_union
+        template <std::size_t r, class Pack>
+        struct Block {};
+
+        template <class Counter, class B>
+        struct Carry {};
+
+        // the blocks, the smallest and latest first
+        template <template <class, class> class Merge, class ... Blocks>
+        struct BlockCounter {
+            struct Pusher {
+                using counter = BlockCounter;
+                template <class P>
+                typename Carry<BlockCounter, Block<0, P>>::value::Pusher operator|(Type<P>*) const;
+            };
+        };
+
+        template <template <class, class> class Merge, class ... Blocks, class B>
+        struct Carry<BlockCounter<Merge, Blocks...>, B> {
+            using value = BlockCounter<Merge, B, Blocks...>;
+        };
+        template <template <class, class> class Merge, std::size_t r, class Older, class Newer, class ... Blocks>
+        struct Carry<BlockCounter<Merge, Block<r, Older>, Blocks...>, Block<r, Newer>> :
+            Carry<BlockCounter<Merge, Blocks...>, Block<r + 1, Merge<Older, Newer>>>
+        {};
+
+        // at most log k blocks are left, the largest one goes first
+        template <class Counter, class Empty>
+        struct JoinBlocks {};
+        template <template <class, class> class Merge, class Empty>
+        struct JoinBlocks<BlockCounter<Merge>, Empty> {
+            using value = Empty;
+        };
+        template <template <class, class> class Merge, std::size_t r, class Pack, class ... Blocks, class Empty>
+        struct JoinBlocks<BlockCounter<Merge, Block<r, Pack>, Blocks...>, Empty> {
+            using value = Merge<typename JoinBlocks<BlockCounter<Merge, Blocks...>, Empty>::value, Pack>;
+        };
+
+        // the merge of Packs... from left to right, Empty if there are none
+        template <template <class, class> class Merge, class Empty, class ... Packs>
+        using merge_blocks = typename JoinBlocks<
+            typename decltype((typename BlockCounter<Merge>::Pusher{} | ... | static_cast<Type<Packs>*>(nullptr)))::counter,
+            Empty
+        >::value;
+
+        template <class ... Packs>
+        struct ConcatBlocks {
+            using value = merge_blocks<concat, Argpass<>, Packs...>;
+        };
+
+        template <class ... Packs>
+        struct ConcatAll {
+            using value = typename ctstd::conditional_using<
+                builtin_pack_at,
+                ConcatByIndex<std::make_index_sequence<detail::total_size<Packs::size...>()>, Packs...>,
+                ConcatBlocks<Packs...>
+            >::value;
+        };
+
+        template <class T>
+        struct Flatten {
+            using value = Argpass<T>;
+        };
+        template <class ... Ts>
+        struct Flatten<Argpass<Ts...>> {
+            using value = typename ConcatAll<typename Flatten<Ts>::value...>::value;
+        };
+    };
+
+    /// The concatenation of the Argpasses Packs...
+    template <class ... Packs>
+    using concat_all = typename detail::ConcatAll<Packs...>::value;
+    /// The leaves of a tree of nested Argpasses, from left to right
+    template <class Args>
+    using flatten = typename detail::Flatten<Args>::value;
+
+
+    /// Sets of types, the membership test is a single is_base_of instead of a scan
+    /// Set<Ts...> must not contain duplicates, so build it with make_set or insert
+    namespace detail {
+        template <class T>
+        struct SetTag {};
+    };
+
+    template <class ... Ts>
+    struct Set : detail::SetTag<Ts>... {
+        using elements = Argpass<Ts...>;
+        constexpr static decltype(sizeof...(Ts)) size = sizeof...(Ts);
+    };
+
+    /// ctstd::True if T is an element of the set S
+    template <class S, class T>
+    using contains = ctstd::is_base_of<detail::SetTag<T>, S>;
+
+    namespace detail {
+        template <class S>
+        struct Inserter {
+            using value = S;
+        };
+        template <class S, class T>
+        Inserter<ctstd::conditional_using<ctstd::to_bool<contains<S, T>>, S, pass_args<Set, concat<typename S::elements, Argpass<T>>>>>
+        operator+(Inserter<S>, Inserter<Argpass<T>>);
+
+        // the elements Ts for which contains<S, T> is Keep
+        template <class S, bool Keep, class ... Ts>
+        using filter_by = pass_args<Set, concat_all<
+            ctstd::conditional_using<ctstd::to_bool<contains<S, Ts>> == Keep, Argpass<Ts>, Argpass<>>...
+        >>;
+
+        template <class S, class U>
+        struct SetOps {};
+        template <class ... Ts, class ... Us>
+        struct SetOps<Set<Ts...>, Set<Us...>> {
+            using set_union = pass_args<Set, concat<Argpass<Ts...>, typename filter_by<Set<Ts...>, false, Us...>::elements>>;
+            using set_intersection = filter_by<Set<Us...>, true, Ts...>;
+            using set_difference = filter_by<Set<Us...>, false, Ts...>;
+        };
+        template <class S, class U>
+        using union_of = typename SetOps<S, U>::set_union;
+
+        // Each element starts as a set of its own, and the sets are merged by the block counter of concat_all,
+        // so each merge is a single filter_by of the newer set by the older one, O(log n) deep
+        template <class Args>
+        struct MakeSet {};
+        template <class ... Ts>
+        struct MakeSet<Argpass<Ts...>> {
+            using value = merge_blocks<union_of, Set<>, Set<Ts>...>;
+        };
+    };
+
+    /// The set of the distinct elements of Args, in order of first occurrence
+    template <class Args>
+    using make_set = typename detail::MakeSet<Args>::value;
+    /// S with T added at the end, unless it's already there
+    template <class S, class T>
+    using insert = typename decltype(detail::Inserter<S>{} + detail::Inserter<Argpass<T>>{})::value;
+    /// The elements of S, then those of U which aren't in S
+    template <class S, class U>
+    using set_union = typename detail::SetOps<S, U>::set_union;
+    /// The elements of S which are in U, in the order of S
+    template <class S, class U>
+    using set_intersection = typename detail::SetOps<S, U>::set_intersection;
+    /// The elements of S which aren't in U, in the order of S
+    template <class S, class U>
+    using set_difference = typename detail::SetOps<S, U>::set_difference;
+
+
+    /// Sorting by a numeric key
+    /// The keys are sorted by a bottom-up merge sort in the constant evaluator, without any template recursion,
+    /// and the result is the permutation of Args
+    namespace detail {
+        template <std::size_t N>
+        struct Permutation {
+            std::size_t index[N + 1];
+        };
+
+        template <std::size_t N, class K>
+        constexpr Permutation<N> stable_sort_indices(const K* keys) {
+            Permutation<N> res{}, buf{};
+            for (std::size_t i = 0; i < N; ++i) {
+                res.index[i] = i;
+            }
+            for (std::size_t width = 1; width < N; width *= 2) {
+                for (std::size_t lo = 0; lo < N; lo += 2 * width) {
+                    std::size_t mid = lo + width < N ? lo + width : N;
+                    std::size_t hi = lo + 2 * width < N ? lo + 2 * width : N;
+                    std::size_t l = lo, r = mid, out = lo;
+                    while (l < mid && r < hi) {
+                        // on equal keys the left one goes first, which keeps the sort stable
+                        buf.index[out++] = keys[res.index[r]] < keys[res.index[l]] ? res.index[r++] : res.index[l++];
+                    }
+                    while (l < mid) buf.index[out++] = res.index[l++];
+                    while (r < hi) buf.index[out++] = res.index[r++];
+                }
+                res = buf;
+            }
+            return res;
+        }
+
+        template <class Args, class KeyFn, class Is>
+        struct Sort {};
+        template <class KeyFn>
+        struct Sort<Argpass<>, KeyFn, std::index_sequence<>> {
+            using value = Argpass<>;
+        };
+        template <class ... Ts, class KeyFn, std::size_t ... Is>
+        struct Sort<Argpass<Ts...>, KeyFn, std::index_sequence<Is...>> {
+            template <class T>
+            using key_of = std::remove_cvref_t<decltype(KeyFn::template __call__<T>::value)>;
+            // the common type of the keys, but a negative Num among the unsigned peano keys needs a signed one
+            using common_key = std::common_type_t<key_of<Ts>...>;
+            using key_type = ctstd::conditional_using<
+                std::is_unsigned_v<common_key> && (std::is_signed_v<key_of<Ts>> || ...),
+                long long,
+                common_key
+            >;
+            // a binary key only keeps its value modulo 2^64
+            static_assert(((ctstd::detail::native_width<typename KeyFn::template __call__<Ts>> <= 64) && ...), "a binary key doesn't fit in 64 bits");
+            static constexpr key_type keys[] = {KeyFn::template __call__<Ts>::value...};
+            static constexpr auto order = detail::stable_sort_indices<sizeof...(Ts)>(keys);
+            using value = Argpass<pack_at<order.index[Is], Ts...>...>;
+        };
+    };
+
+    /// Args sorted by the key KeyFn::__call__<T>, keeping the order of equal keys
+    /// The keys are numbers, like peano integers or Nums, and are compared by their `value`s
+    /// Binary keys must fit in 64 bits
+    /// 
+    /// Example:
+    /// ```cpp
+    /// struct SizeOf { template <class T> using __call__ = ctstd::Num<sizeof(T)>; };
+    /// sort<Argpass<long, char, int>, SizeOf> // Argpass<char, int, long>
+    /// ```
+    template <class Args, class KeyFn>
+    using sort = typename detail::Sort<Args, KeyFn, std::make_index_sequence<Args::size>>::value;
+
+
+    /// Higher-order algorithms, the functions follow the __call__ convention of Lambda
+    namespace detail {
+        template <class F, class Args>
+        struct Map {};
+        template <class F, class ... Ts>
+        struct Map<F, Argpass<Ts...>> {
+            using value = Argpass<typename F::template __call__<Ts>...>;
+        };
+
+        template <class Pred, class Args>
+        struct Filter {};
+        template <class Pred, class ... Ts>
+        struct Filter<Pred, Argpass<Ts...>> {
+            using value = concat_all<
+                ctstd::conditional_using<ctstd::to_bool<typename Pred::template __call__<Ts>>, Argpass<Ts>, Argpass<>>...
+            >;
+        };
+
+        // the fold is sequential, but the operator applies each step without nesting templates
+        template <class F, class Acc>
+        struct Folder {
+            using value = Acc;
+        };
+        template <class F, class Acc, class T>
+        Folder<F, typename F::template __call__<Acc, T>> operator<<(Folder<F, Acc>, Argpass<T>*);
+
+        template <class F, class Init, class Args>
+        struct Foldl {};
+        template <class F, class Init, class ... Ts>
+        struct Foldl<F, Init, Argpass<Ts...>> {
+            using value = typename decltype((Folder<F, Init>{} << ... << static_cast<Argpass<Ts>*>(nullptr)))::value;
+        };
+
+        template <class A, class B>
+        struct Zip {};
+        template <class ... Ts, class ... Us>
+        struct Zip<Argpass<Ts...>, Argpass<Us...>> {
+            static_assert(sizeof...(Ts) == sizeof...(Us), "argpass::zip of Argpasses of different sizes");
+            using value = Argpass<Argpass<Ts, Us>...>;
+        };
+
+        template <class Args, class Is>
+        struct Enumerate {};
+        template <class ... Ts, std::size_t ... Is>
+        struct Enumerate<Argpass<Ts...>, std::index_sequence<Is...>> {
+            using value = Argpass<Argpass<ctstd::Num<Is>, Ts>...>;
+        };
+    };
+
+    /// Argpass<F::__call__<Ts>...>
+    template <class F, class Args>
+    using map = typename detail::Map<F, Args>::value;
+    /// The elements T of Args for which Pred::__call__<T> is ctstd::True
+    template <class Pred, class Args>
+    using filter = typename detail::Filter<Pred, Args>::value;
+    /// F::__call__<... F::__call__<F::__call__<Init, T1>, T2> ..., Tn>
+    template <class F, class Init, class Args>
+    using foldl = typename detail::Foldl<F, Init, Args>::value;
+    /// Argpass<Argpass<A1, B1>, ..., Argpass<An, Bn>>
+    template <class A, class B>
+    using zip = typename detail::Zip<A, B>::value;
+    /// Argpass<Argpass<Num<0>, T0>, ..., Argpass<Num<n-1>, Tn-1>>
+    template <class Args>
+    using enumerate = typename detail::Enumerate<Args, std::make_index_sequence<Args::size>>::value;
+};
+
+namespace argpass {
+    /// Persistent lists: Cons<H, T> is the list T with H prepended, and Nil is the empty list
+    /// Prepending makes one new type and shares the tail, while putting an element into
+    /// an Argpass<Ts...> makes a new pack of all the elements
+    /// Growing a list by n elements in a loop is then O(n) instead of O(n²)
+    ///
+    /// Usage:
+    /// ```cpp
+    /// using l = Cons<int, Cons<char, Nil>>;
+    /// static_assert(std::is_same_v<to_argpass<l>, Argpass<int, char>>);
+    /// ```
+    struct Nil {};
+
+    template <class H, class T>
+    struct Cons {
+        using head = H;
+        using tail = T;
+    };
+
+    namespace detail {
+        template <class L>
+        struct ListBuilder {
+            using value = L;
+        };
+        template <class T, class L>
+        ListBuilder<Cons<T, L>> operator*(Argpass<T>*, ListBuilder<L>);
+
+        template <class Args>
+        struct FromArgpass {};
+        template <class ... Ts>
+        struct FromArgpass<Argpass<Ts...>> {
+            using value = typename decltype((static_cast<Argpass<Ts>*>(nullptr) * ... * ListBuilder<Nil>{}))::value;
+        };
+
+        // Peels 2^j nodes off the list L: chunk is their Argpass, and rest the list after them
+        // The two halves are peeled one after the other, not one inside the other, so the depth is j
+        template <unsigned j, class L>
+        struct Peel {
+            using first = Peel<j - 1, L>;
+            using second = Peel<j - 1, typename first::rest>;
+            using chunk = typename Concatter<typename first::chunk, typename second::chunk>::value;
+            using rest = typename second::rest;
+        };
+        template <unsigned j>
+        struct Peel<j, Nil> {
+            using chunk = Argpass<>;
+            using rest = Nil;
+        };
+        template <class H, class T>
+        struct Peel<0, Cons<H, T>> {
+            using chunk = Argpass<H>;
+            using rest = T;
+        };
+        template <class H0, class H1, class H2, class H3, class H4, class H5, class H6, class H7, class T>
+        struct Peel<3, Cons<H0, Cons<H1, Cons<H2, Cons<H3, Cons<H4, Cons<H5, Cons<H6, Cons<H7, T>>>>>>>>> {
+            using chunk = Argpass<H0, H1, H2, H3, H4, H5, H6, H7>;
+            using rest = T;
+        };
+
+        // The chunks double in size, so a list of n nodes is log n chunks, and the recursion is O(log n) deep
+        // Appending the elements themselves would copy all of them at every step, instead only the
+        // chunks are carried along, and they are concatenated once at the end
+        template <class L, unsigned j, class ... Chunks>
+        struct ToArgpass : ToArgpass<typename Peel<j, L>::rest, j + 1, Chunks..., typename Peel<j, L>::chunk> {};
+        template <unsigned j, class ... Chunks>
+        struct ToArgpass<Nil, j, Chunks...> {
+            using value = typename ConcatAll<Chunks...>::value;
+        };
+    };
+
+    /// The list of the elements of Args, in O(n) instantiations
+    template <class Args>
+    using from_argpass = typename detail::FromArgpass<Args>::value;
+    /// The Argpass of the elements of the list L, in O(n) instantiations
+    template <class L>
+    using to_argpass = typename detail::ToArgpass<L, 0>::value;
+};
@@ -6,6 +6,7 @@ namespace peano {
     namespace detail { struct IsPeanoInteger {}; };
     struct Zero : detail::IsPeanoInteger {
         using Prev = ctstd::None;
+        static constexpr unsigned value = 0;
     };
     template <class T>
     using is_peano_integer = ctstd::is_base_of<detail::IsPeanoInteger, T>;
@@ -13,8 +14,10 @@ namespace peano {
 
     using _0 = Zero;
 
+    // The numeric value is cached in each Succ, so the comparisons below don't have to peel the Succs
     template <class T> struct Succ : detail::IsPeanoInteger {
         using Prev = T;
+        static constexpr unsigned value = T::value + 1;
     };
 
     using _1 = Succ<Zero>;
@@ -31,9 +34,43 @@ namespace peano {
     using _12 = Succ<_11>;
 
     namespace detail {
+        // Applies Succ N times to T, splitting N in halves, so the recursion depth is O(log N)
+        // The Succs are completed from the bottom up, so that their cached values never recurse deeply
+        template <unsigned N, class T>
+        struct SuccPow {
+            using half = typename SuccPow<N / 2, T>::value;
+            using value = typename SuccPow<N - N / 2, half>::value;
+        };
+        // The leaves apply up to 4 Succs at once, which keeps the number of helper classes below N
+        template <class T>
+        struct SuccPow<4, T> {
+            static_assert(Succ<Succ<Succ<Succ<T>>>>::value == T::value + 4);
+            using value = Succ<Succ<Succ<Succ<T>>>>;
+        };
+        template <class T>
+        struct SuccPow<3, T> {
+            static_assert(Succ<Succ<Succ<T>>>::value == T::value + 3);
+            using value = Succ<Succ<Succ<T>>>;
+        };
+        template <class T>
+        struct SuccPow<2, T> {
+            static_assert(Succ<Succ<T>>::value == T::value + 2);
+            using value = Succ<Succ<T>>;
+        };
+        template <class T>
+        struct SuccPow<1, T> {
+            static_assert(Succ<T>::value == T::value + 1);
+            using value = Succ<T>;
+        };
+        template <class T>
+        struct SuccPow<0, T> {
+            using value = T;
+        };
+
+        // Integer<N> reuses Integer<N/2>, so the depth stays O(log N)
         template <unsigned N>
         struct IntegerImpl {
-            using value = Succ<typename IntegerImpl<N-1>::value>;
+            using value = typename SuccPow<N - N / 2, typename IntegerImpl<N / 2>::value>::value;
         };
         template <>
         struct IntegerImpl<0> {
@@ -45,6 +82,7 @@ namespace peano {
     using Integer = typename detail::IntegerImpl<N>::value;
 
     static_assert(std::is_same_v<_12, Integer<12>>);
+    static_assert(std::is_same_v<Succ<Integer<100>>, Integer<101>>);
     namespace detail {
         template <class A, class B>
         struct Add {
@@ -77,90 +115,49 @@ namespace peano {
     static_assert(std::is_same_v<mult<_2, _2>, _4>);
 
     template <class T>
-    constexpr unsigned cast = cast<typename T::Prev> + 1;
-
-    template <>
-    constexpr unsigned cast<Zero> = 0;
+    constexpr unsigned cast = T::value;
 
     static_assert(cast<_11> == 11);
 
     namespace detail {
-        template <class A, class B>
-        struct Minus {
-            using value = typename Minus<typename A::Prev, typename B::Prev>::value;
-        };
-        template <class A>
-        struct Minus<A, A> {
-            using value = Zero;
-        };
-        template <class A>
-        struct Minus<A, Zero> {
-            using value = A;
-        };
-        template <class B>
-        struct Minus<Zero, B> {
-            using value = Zero;
-        };
+        // saturating, like the Peano predecessor
+        constexpr unsigned minus_value(unsigned a, unsigned b) { return a > b ? a - b : 0; }
     };
-    
+
     template <class A, class B>
-    using minus = typename detail::Minus<A, B>::value;
+    using minus = Integer<detail::minus_value(A::value, B::value)>;
 
     static_assert(std::is_same_v<minus<_2, _3>, _0>);
     static_assert(std::is_same_v<minus<_3, _3>, _0>);
     static_assert(std::is_same_v<minus<_4, _3>, _1>);
 
-
-    namespace detail {
-        template <class A, class B>
-        struct Leq {
-            using value = typename Leq<A, typename B::Prev>::value;
-        };
-        template <class A>
-        struct Leq<A, A> {
-            using value = ctstd::True;
-        };
-        template <class A>
-        struct Leq<A, ctstd::None> {
-            using value = ctstd::False;
-        };
-    };
-
     template <class A, class B>
-    using leq = typename detail::Leq<A, B>::value;
+    using leq = ctstd::conditional_using<(A::value <= B::value), ctstd::True, ctstd::False>;
 
     static_assert(std::is_same_v<leq<_4, _8>, ctstd::True>);
     static_assert(std::is_same_v<leq<_4, _4>, ctstd::True>);
     static_assert(std::is_same_v<leq<_4, _3>, ctstd::False>);
 
+    template <class A, class B>
+    using eq = ctstd::conditional_using<(A::value == B::value), ctstd::True, ctstd::False>;
+
+    static_assert(std::is_same_v<eq<_4, _4>, ctstd::True>);
+    static_assert(std::is_same_v<eq<_4, _3>, ctstd::False>);
+
     namespace detail {
-        template <class A, class B>
-        struct Div {
-            using value = typename ctstd::conditional_using<
-                std::is_same_v<leq<A, B>, ctstd::True> && !std::is_same_v<A, B>,
-                Zero,
-                Succ<typename Div<minus<A, B>, B>::value>
-            >;
-            using remainder = typename ctstd::conditional_using<
-                std::is_same_v<leq<A, B>, ctstd::True> && !std::is_same_v<A, B>,
-                A,
-                typename Div<minus<A, B>, B>::remainder
-            >;
-        };
-        template <class B> 
-        struct Div<Zero, B> {
-            using value = Zero;
-            using remainder = Zero;
-        };
+        // zero divided by anything is zero, as in the recursive definition
+        constexpr unsigned div_value(unsigned a, unsigned b) { return a == 0 ? 0 : a / b; }
+        constexpr unsigned remainder_value(unsigned a, unsigned b) { return a == 0 ? 0 : a % b; }
     };
     template <class A, class B>
-    using div = typename detail::Div<A, B>::value;
+    using div = Integer<detail::div_value(A::value, B::value)>;
 
     template <class A, class B>
-    using remainder = typename detail::Div<A, B>::remainder;
+    using remainder = Integer<detail::remainder_value(A::value, B::value)>;
 
     static_assert(std::is_same_v<div<_3, _2>, _1>);
     static_assert(std::is_same_v<remainder<_3, _2>, _1>);
     static_assert(std::is_same_v<remainder<_2, _2>, _0>);
+    static_assert(std::is_same_v<leq<Integer<500>, Integer<499>>, ctstd::False>);
+    static_assert(std::is_same_v<minus<Integer<500>, Integer<498>>, _2>);
 };
-
@@ -2,6 +2,7 @@
 #include "cexpr_control.hpp"
 #include "peano.hpp"
 #include "ctstd.hpp"
+#include "containers.hpp"
 #include <iostream>
 #include <array>
 
@@ -29,6 +30,20 @@ namespace prereqs {
     static_assert(is_base_of__boolean<b, b>::value, "b is derived from b");
     static_assert(!is_base_of__boolean<c, b>::value, "b isn't derived from c");
     static_assert(!is_base_of__boolean<d, b>::value, "b isn't derived from d");
+
+    struct e;
+    static_assert(!is_base_of__boolean<a, e>::value, "an incomplete type isn't derived from anything");
+    static_assert(is_base_of__boolean<e, e>::value, "an incomplete type is derived from itself");
+    // the same answers with and without CTSTD_NO_INTRINSICS
+    static_assert(!is_base_of__boolean<a, b&>::value, "a reference isn't derived from anything");
+    static_assert(!is_base_of__boolean<a&, b>::value, "nothing is derived from a reference");
+    static_assert(!is_base_of__boolean<int, int>::value, "a non-class type isn't derived from itself");
+    static_assert(!is_base_of__boolean<void, a>::value, "nothing is derived from void");
+    struct f;
+    static_assert(!is_base_of__boolean<a, f>::value, "f is only declared");
+    struct f : a {};
+    static_assert(!is_base_of__boolean<a, f>::value, "the first answer sticks once f is defined");
+    static_assert(std::is_same_v<ctstd::is_number<e>, ctstd::False>, "a declared variable name isn't a number");
 };
 
 // testing whether the assignment mechanism works well with all types, including the special ones like void, const, references, etc.
@@ -378,6 +393,18 @@ namespace peano_order_test {
     static_assert(std::is_same_v<value<c, RE>, ctstd::False>);
 };
 
+// Integer<N> is built in O(log N) template depth, and the arithmetic on it doesn't peel Succs
+namespace peano_large_test {
+    using big = peano::Integer<2000>;
+
+    static_assert(std::is_same_v<peano::Succ<big>, peano::Integer<2001>>, "Integer<N> is the canonical Succ<...> type");
+    static_assert(peano::cast<big> == 2000);
+    static_assert(std::is_same_v<peano::leq<big, peano::Integer<1999>>, ctstd::False>);
+    static_assert(std::is_same_v<peano::minus<peano::Integer<2001>, big>, peano::_1>);
+    static_assert(std::is_same_v<peano::div<big, peano::Integer<999>>, peano::_2>);
+    static_assert(std::is_same_v<peano::remainder<big, peano::Integer<999>>, peano::_2>);
+};
+
 namespace ctstd_adv_test {
     using namespace type_var;
     using namespace cexpr_control;
@@ -916,6 +943,1140 @@ namespace big_recursion_test_1 {
 };
 
 
+namespace expression_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+
+    template <class> struct __run_line {};
+
+    struct a {};
+    struct b {};
+    struct c {};
+
+    run_line : Assign<a, _2, RE> {};
+    run_line : Assign<b, _3, RE> {};
+    run_line : Assign<c, True, RE> {};
+
+    static_assert(std::is_same_v<evaluate<a, RE>, _2>, "a variable is an expression");
+    static_assert(std::is_same_v<evaluate<_5, RE>, _5>, "a constant is an expression");
+    static_assert(std::is_same_v<evaluate<expr::add<expr::mult<a, _3>, _1>, RE>, _7>, "nested arithmetic works correctly");
+    static_assert(std::is_same_v<evaluate<expr::mult<a, expr::add<a, b>>, RE>, Integer<10>>, "repeated variables are loaded once and reused");
+    static_assert(std::is_same_v<evaluate<expr::minus<expr::divide<_7, a>, expr::remainder<_7, b>>, RE>, _2>, "division and remainder work correctly");
+    static_assert(std::is_same_v<evaluate<expr::eq<expr::remainder<b, _2>, _1>, RE>, True>, "eq works correctly");
+    static_assert(std::is_same_v<evaluate<expr::leq<b, a>, RE>, False>, "leq works correctly");
+    static_assert(std::is_same_v<evaluate<expr::And<c, expr::Not<expr::leq<b, a>>>, RE>, True>, "boolean operations mix with comparisons");
+    static_assert(std::is_same_v<evaluate<expr::Xor<c, expr::Or<False, c>>, RE>, False>, "Xor and Or work correctly");
+
+    static_assert(std::is_same_v<
+        ctstd::detail::CollectVars<argpass::Argpass<>, expr::add<expr::mult<a, b>, expr::add<b, expr::mult<a, _3>>>>::value, 
+        argpass::Argpass<a, b>
+    >, "each variable is collected once, in order of occurrence");
+
+    struct d {};
+    struct e {};
+    struct f {};
+
+    run_line: Assign<d, _7, RE> {};
+    run_line: Assign<e, _0, RE> {};
+    run_line: Assign<f, True, RE> {};
+
+    struct CollatzStep {
+        template <class _>
+        struct __call__ :
+            if_else<
+                evaluate<expr::eq<expr::remainder<d, _2>, _0>, RE>,
+                Assignment<d>,
+                evaluate<expr::divide<d, _2>, RE>,
+                evaluate<expr::add<expr::mult<d, _3>, _1>, RE>,
+                RE
+            >,
+            Assign<e, evaluate<expr::add<e, _1>, RE>, RE>,
+            Assign<f, evaluate<expr::Not<expr::eq<d, _1>>, RE>, RE>
+        {};
+    };
+
+    run_line: DoWhile<CollatzStep, f, RE> {};
+
+#ifdef __clang__
+    static_assert(to_bool<eq<d, Integer<1>, RE>>);
+    static_assert(to_bool<eq<e, Integer<16>, RE>>);
+#elif __GNUG__
+    static_assert(to_bool<eq<d, Integer<2>, RE>>);
+    static_assert(to_bool<eq<e, Integer<18>, RE>>);
+#endif
+};
+
+
+namespace native_value_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+
+    template <class> struct __run_line {};
+
+    struct a {};
+    struct b {};
+
+    run_line : Assign_v<a, 42, RE> {};
+    static_assert(value_v<a, RE> == 42, "Assign_v stores a native value");
+    static_assert(std::is_same_v<value<a, RE>, Num<42>>, "native values are stored as Num");
+
+    run_line : Assign<b, _5, RE> {};
+    static_assert(value_v<b, RE> == 5, "value_v also reads peano integers");
+
+    static_assert(std::is_same_v<add<a, _1, RE>, Num<43>>, "adding a peano integer to a native value gives a native value");
+    static_assert(std::is_same_v<add<_2, _3, RE>, _5>, "peano integers stay peano integers");
+    static_assert(std::is_same_v<mult<a, b, RE>, Num<210>>, "multiplying variables works correctly");
+    static_assert(std::is_same_v<divide<a, Num<5>, RE>, Num<8>>, "dividing by a native constant works correctly");
+    static_assert(std::is_same_v<remainder<a, Num<5>, RE>, Num<2>>, "remainder works correctly");
+    static_assert(std::is_same_v<minus<a, b, RE>, Num<37>>, "minus works correctly");
+    static_assert(std::is_same_v<minus<b, a, RE>, Num<0>>, "minus saturates at zero for native values too");
+    static_assert(std::is_same_v<minus<Num<3u>, Num<5u>, RE>, Num<0u>>, "minus doesn't wrap around unsigned values");
+    static_assert(std::is_same_v<minus<Num<-5>, Num<3>, RE>, Num<-8>>, "signed native values go negative");
+    static_assert(std::is_same_v<minus<Num<3>, Num<5>, RE>, Num<-2>>, "signed native values go negative");
+    static_assert(std::is_same_v<leq<b, a, RE>, True>, "leq works correctly");
+    static_assert(std::is_same_v<leq<a, Num<41>, RE>, False>, "leq works correctly");
+    static_assert(std::is_same_v<eq<a, Num<42>, RE>, True>, "eq compares native values by value");
+    static_assert(std::is_same_v<eq<Num<5>, b, RE>, True>, "eq compares native values with peano integers by value");
+    static_assert(std::is_same_v<eq<a, True, RE>, False>, "eq of a number and a non-number is False");
+    static_assert(std::is_same_v<evaluate<expr::add<expr::mult<a, b>, Num<1>>, RE>, Num<211>>, "expressions work with native values");
+
+    // Numbers which are far out of reach for peano integers
+    struct c {};
+    struct d {};
+    struct e {};
+
+    run_line: Assign_v<c, 3637, RE> {};
+    run_line: Assign_v<d, 0, RE> {};
+    run_line: Assign<e, True, RE> {};
+
+    struct CollatzStep {
+        template <class _>
+        struct __call__ :
+            if_else<
+                eq<remainder<c, Num<2>, RE>, Num<0>, RE>,
+                Assignment<c>,
+                divide<c, Num<2>, RE>,
+                add<mult<c, Num<3>, RE>, Num<1>, RE>,
+                RE
+            >,
+            Assign<d, add<d, Num<1>, RE>, RE>,
+            Assign<e, Not<eq<c, Num<1>, RE>, RE>, RE>
+        {};
+    };
+
+    run_line: DoWhile<CollatzStep, e, RE> {};
+
+    // 3637 reaches 10912 and takes 17 steps
+#ifdef __clang__
+    static_assert(value_v<c, RE> == 1);
+    static_assert(value_v<d, RE> == 17);
+#elif __GNUG__
+    static_assert(value_v<c, RE> == 2);
+    static_assert(value_v<d, RE> == 19);
+#endif
+
+    struct i {};
+    struct sum {};
+    struct i_leq_20 {};
+    run_line : Assign_v<i, 0, RE> {};
+    run_line : Assign_v<sum, 0, RE> {};
+    run_line : Assign<i_leq_20, True, RE> {};
+
+    struct SumOfFirstIntegers {
+        template <class _>
+        struct __call__ : 
+            Assign<i, add<i, Num<1>, RE>, RE>,
+            Assign<sum, add<sum, mult<i, Num<1000>, RE>, RE>, RE>,
+            Assign<i_leq_20, leq<i, Num<20>, RE>, RE>
+        {};
+    };
+
+    run_line : DoWhile<SumOfFirstIntegers, i_leq_20, RE> {};
+
+#ifdef __clang__
+    static_assert(value_v<sum, RE> == 231000);
+#elif __GNUG__
+    static_assert(value_v<sum, RE> == 253000);
+#endif
+};
+
+
+namespace apply_constexpr_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+
+    template <class> struct __run_line {};
+
+    using IsPrime = decltype([](unsigned n) {
+        if (n < 2) return false;
+        for (unsigned d = 2; d * d <= n; ++d) {
+            if (n % d == 0) return false;
+        }
+        return true;
+    });
+    using Popcount = decltype([](unsigned long long n) {
+        unsigned count = 0;
+        for (; n; n &= n - 1) ++count;
+        return count;
+    });
+    using Choose = decltype([](bool c, long x, long y) { return c ? x : y; });
+    using Hash = decltype([](unsigned long long x) { 
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return x;
+    });
+
+    struct a {};
+    struct b {};
+    struct c {};
+
+    run_line : Assign<a, _7, RE> {};
+    run_line : Assign_v<b, 1000003, RE> {};
+    run_line : Assign<c, False, RE> {};
+
+    static_assert(std::is_same_v<apply_constexpr<IsPrime, a, RE>, True>, "booleans are returned as True/False");
+    static_assert(std::is_same_v<apply_constexpr<IsPrime, _12, RE>, False>, "constants work as operands");
+    static_assert(std::is_same_v<apply_constexpr<IsPrime, b, RE>, True>, "native values work as operands");
+    static_assert(std::is_same_v<apply_constexpr<Popcount, Integer<255>, RE>, _8>, "integers are returned as peano integers");
+    static_assert(std::is_same_v<apply_constexpr<Popcount, b, RE>, Num<9u>>, "integers are returned as Num if an operand is a Num");
+    static_assert(std::is_same_v<apply_constexpr<Choose, c, a, _3, RE>, _3>, "booleans are passed as bool");
+    static_assert(std::is_same_v<apply_constexpr<Choose, expr::Not<c>, Num<-1>, a, RE>, Num<-1l>>, "expressions work as operands");
+    static_assert(apply_constexpr<Hash, b, RE>::value == Hash{}(1000003), "the result isn't truncated");
+    static_assert(std::is_same_v<apply_constexpr<IsPrime, Integer<1000>, RE>, False>);
+    static_assert(std::is_same_v<apply_constexpr<Hash, binary::Integer<1000003>, RE>, binary::Integer<Hash{}(1000003)>>, 
+        "integers are returned as binary integers if an operand is binary");
+    static_assert(std::is_same_v<apply_constexpr<Choose, c, binary::Integer<255>, _3, RE>, binary::Integer<3>>, "binary wins over peano");
+
+    struct d {};
+    run_line : Assign<d, apply_constexpr<Popcount, mult<a, Num<9>, RE>, RE>, RE> {};
+    static_assert(value_v<d, RE> == 6, "the result can be stored and read back");
+};
+
+
+namespace binary_integer_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+
+    template <class> struct __run_line {};
+
+    using binary::Bits;
+    using Big = binary::mult<binary::Integer<(1ull << 40)>, binary::Integer<(1ull << 40)>>;
+
+    static_assert(std::is_same_v<add<binary::Integer<999>, binary::Integer<25>, RE>, binary::Integer<1024>>, "binary integers add correctly");
+    static_assert(std::is_same_v<add<binary::Integer<999>, _5, RE>, binary::Integer<1004>>, "peano integers are converted to binary");
+    static_assert(std::is_same_v<add<binary::Integer<999>, Num<5>, RE>, Num<1004>>, "native values dominate binary integers");
+    static_assert(std::is_same_v<add<binary::Integer<(1ull << 63)>, Num<1ull>, RE>, Num<(1ull << 63) + 1>>, "64-bit binary integers fit in native values");
+    static_assert(std::is_same_v<divide<Big, binary::Integer<(1ull << 60)>, RE>, binary::Integer<(1ull << 20)>>, "binary integers go past 64 bits");
+    static_assert(std::is_same_v<remainder<add<Big, _3, RE>, binary::Integer<(1ull << 60)>, RE>, binary::Integer<3>>, "remainder works past 64 bits");
+    static_assert(std::is_same_v<leq<binary::Integer<(1ull << 63)>, Big, RE>, True>, "leq works past 64 bits");
+    static_assert(std::is_same_v<minus<_3, binary::Integer<5>, RE>, binary::Zero>, "minus saturates at zero");
+    static_assert(std::is_same_v<eq<_12, binary::Integer<12>, RE>, True>, "eq compares peano and binary integers by value");
+    static_assert(std::is_same_v<binary::to_peano<binary::Integer<12>>, _12>, "binary integers convert to peano");
+    static_assert(std::is_same_v<evaluate<expr::mult<expr::add<binary::Integer<3>, _4>, _6>, RE>, binary::Integer<42>>, "expressions work with binary integers");
+
+    struct x {};
+    struct i {};
+    struct i_leq_6 {};
+    run_line : Assign<x, binary::Integer<1>, RE> {};
+    run_line : Assign<i, _0, RE> {};
+    run_line : Assign<i_leq_6, True, RE> {};
+
+    struct TimesKilo {
+        template <class _>
+        struct __call__ :
+            Assign<i, add<i, _1, RE>, RE>,
+            Assign<x, mult<x, binary::Integer<1024>, RE>, RE>,
+            Assign<i_leq_6, leq<i, _6, RE>, RE>
+        {};
+    };
+
+    run_line : DoWhile<TimesKilo, i_leq_6, RE> {};
+
+    // x goes past 2^64, out of reach for native integers
+#ifdef __clang__
+    static_assert(std::is_same_v<divide<x, binary::Integer<(1ull << 60)>, RE>, binary::Integer<(1ull << 10)>>);
+#elif __GNUG__
+    static_assert(std::is_same_v<divide<x, binary::Integer<(1ull << 60)>, RE>, binary::Integer<(1ull << 20)>>);
+#endif
+};
+
+namespace reduction_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    static_assert(std::is_same_v<all_of<Argpass<True, True, True>, RE>, True>, "all_of works correctly");
+    static_assert(std::is_same_v<all_of<Argpass<True, False, True>, RE>, False>, "all_of works correctly");
+    static_assert(std::is_same_v<any_of<Argpass<False, False, True>, RE>, True>, "any_of works correctly");
+    static_assert(std::is_same_v<all_of<Argpass<>, RE>, True>, "all_of of nothing is True");
+    static_assert(std::is_same_v<any_of<Argpass<>, RE>, False>, "any_of of nothing is False");
+    static_assert(std::is_same_v<count_true<Argpass<True, False, True, True>, RE>, _3>, "count_true works correctly");
+
+    static_assert(std::is_same_v<sum<Argpass<_1, _2, _3, _4>, RE>, _10>, "sum of peano integers is a peano integer");
+    static_assert(std::is_same_v<sum<Argpass<>, RE>, _0>, "sum of nothing is zero");
+    static_assert(std::is_same_v<sum<Argpass<_1, Num<1000>, _3>, RE>, Num<1004>>, "sum with a Num is a Num");
+    static_assert(std::is_same_v<sum<Argpass<_1, binary::Integer<1000>>, RE>, binary::Integer<1001>>, "sum with a binary integer is binary");
+    static_assert(std::is_same_v<product<Argpass<_2, _3, _4>, RE>, Integer<24>>, "product works correctly");
+    static_assert(std::is_same_v<product<Argpass<Num<1000>, Num<1000>, _3>, RE>, Num<3000000>>, "product works correctly");
+    static_assert(std::is_same_v<max_of<Argpass<_2, _7, _4>, RE>, _7>, "max_of works correctly");
+    static_assert(std::is_same_v<max_of<Argpass<_2, Num<9>, _4>, RE>, Num<9>>, "max_of returns the largest operand");
+    static_assert(std::is_same_v<sum<Argpass<expr::mult<_2, _3>, _4>, RE>, _10>, "operands may be expressions");
+
+    struct a {};
+    struct b {};
+    struct c {};
+    struct t {};
+    struct f {};
+    run_line : Assign<a, _5, RE> {};
+    run_line : Assign_v<b, 10, RE> {};
+    run_line : Assign<c, _2, RE> {};
+    run_line : Assign<t, True, RE> {};
+    run_line : Assign<f, False, RE> {};
+
+    static_assert(std::is_same_v<sum<Argpass<a, b, c, a>, RE>, Num<22>>, "variables are read");
+    static_assert(std::is_same_v<product<Argpass<a, c, a>, RE>, Integer<50>>, "variables are read");
+    static_assert(std::is_same_v<max_of<Argpass<a, c>, RE>, _5>, "variables are read");
+    static_assert(std::is_same_v<all_of<Argpass<t, t, True>, RE>, True>, "variables are read");
+    static_assert(std::is_same_v<any_of<Argpass<f, False, f>, RE>, False>, "variables are read");
+    static_assert(std::is_same_v<count_true<Argpass<t, f, t, expr::Not<f>>, RE>, _3>, "variables are read");
+
+    // Summing the squares up to 13, GCC runs an additional step
+    struct i {};
+    struct squares {};
+    struct cond {};
+    run_line : Assign<i, _0, RE> {};
+    run_line : Assign_v<squares, 0, RE> {};
+    run_line : Assign<cond, True, RE> {};
+
+    struct SumOfSquares {
+        template <class _>
+        struct __call__ :
+            Assign<i, add<i, _1, RE>, RE>,
+            Assign<squares, sum<Argpass<squares, expr::mult<i, i>>, RE>, RE>,
+            Assign<cond, all_of<Argpass<expr::leq<i, _12>, t, expr::Not<f>>, RE>, RE>
+        {};
+    };
+
+    run_line : DoWhile<SumOfSquares, cond, RE> {};
+
+#ifdef __clang__
+    static_assert(value_v<squares, RE> == 819);
+#elif __GNUG__
+    static_assert(value_v<squares, RE> == 1015);
+#endif
+};
+
+namespace argpass_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    using L = Argpass<int, void, const int&, int, char[3], ctstd::None>;
+
+    static_assert(argpass::size<L> == 6, "size works correctly");
+    static_assert(argpass::size<Argpass<>> == 0, "size works correctly");
+    static_assert(std::is_same_v<argpass::at<L, 0>, int>, "at works correctly");
+    static_assert(std::is_same_v<argpass::at<L, 1>, void>, "at works with void");
+    static_assert(std::is_same_v<argpass::at<L, 2>, const int&>, "at works with references");
+    static_assert(std::is_same_v<argpass::at<L, 3>, int>, "at works with repeated types");
+    static_assert(std::is_same_v<argpass::at<L, 5>, ctstd::None>, "at works correctly");
+    static_assert(std::is_same_v<argpass::take<L, 3>, Argpass<int, void, const int&>>, "take works correctly");
+    static_assert(std::is_same_v<argpass::take<L, 0>, Argpass<>>, "take works correctly");
+    static_assert(std::is_same_v<argpass::drop<L, 4>, Argpass<char[3], ctstd::None>>, "drop works correctly");
+    static_assert(std::is_same_v<argpass::drop<L, 6>, Argpass<>>, "drop works correctly");
+    static_assert(std::is_same_v<argpass::slice<L, 1, 4>, Argpass<void, const int&, int>>, "slice works correctly");
+    static_assert(std::is_same_v<argpass::slice<L, 2, 2>, Argpass<>>, "slice works correctly");
+
+    static_assert(std::is_same_v<argpass::concat_all<Argpass<int>, Argpass<>, Argpass<void, char>, Argpass<int>>, Argpass<int, void, char, int>>, "concat_all works correctly");
+    static_assert(std::is_same_v<argpass::concat_all<>, Argpass<>>, "concat_all of nothing is empty");
+    static_assert(std::is_same_v<
+        argpass::detail::ConcatByIndex<std::make_index_sequence<4>, Argpass<int>, Argpass<>, Argpass<void, char>, Argpass<int>>::value,
+        Argpass<int, void, char, int>
+    >, "concatenation by index works without the builtins too");
+    static_assert(std::is_same_v<
+        argpass::detail::ConcatBlocks<Argpass<int>, Argpass<>, Argpass<void, char>, Argpass<int>, Argpass<char&>>::value,
+        Argpass<int, void, char, int, char&>
+    >, "concatenation by blocks works with the builtins too");
+    static_assert(std::is_same_v<argpass::concat_all<L>, L>, "concat_all works correctly");
+    static_assert(std::is_same_v<
+        argpass::flatten<Argpass<int, Argpass<void, Argpass<>, Argpass<char, Argpass<int&>>>, L>>, 
+        argpass::concat_all<Argpass<int, void, char, int&>, L>
+    >, "flatten works correctly");
+    static_assert(argpass::size<argpass::concat_all<L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L>> == 96, "concat_all works correctly");
+
+    using S = argpass::make_set<Argpass<int, void, int, char, void, const int&>>;
+    static_assert(std::is_same_v<S, argpass::Set<int, void, char, const int&>>, "make_set removes the duplicates");
+    static_assert(std::is_same_v<argpass::contains<S, char>, True>, "contains works correctly");
+    static_assert(std::is_same_v<argpass::contains<S, const int>, False>, "contains works correctly");
+    static_assert(std::is_same_v<argpass::insert<S, char>, S>, "insert doesn't add duplicates");
+    static_assert(std::is_same_v<argpass::insert<S, long>, argpass::Set<int, void, char, const int&, long>>, "insert works correctly");
+    static_assert(std::is_same_v<argpass::make_set<Argpass<>>, argpass::Set<>>, "make_set works correctly");
+    static_assert(std::is_same_v<
+        argpass::make_set<Argpass<_1, _2, _1, _3, _4, _5, _2, _6, _7, _8, _9, _3, _9, _0>>,
+        argpass::Set<_1, _2, _3, _4, _5, _6, _7, _8, _9, _0>
+    >, "make_set works on more than 8 elements");
+
+    using T = argpass::Set<long, char, int>;
+    static_assert(std::is_same_v<argpass::set_union<S, T>, argpass::Set<int, void, char, const int&, long>>, "set_union works correctly");
+    static_assert(std::is_same_v<argpass::set_intersection<S, T>, argpass::Set<int, char>>, "set_intersection works correctly");
+    static_assert(std::is_same_v<argpass::set_difference<S, T>, argpass::Set<void, const int&>>, "set_difference works correctly");
+    static_assert(std::is_same_v<argpass::set_difference<T, T>, argpass::Set<>>, "set_difference works correctly");
+
+    struct SizeOf { template <class T> using __call__ = Num<sizeof(T)>; };
+    struct Self { template <class T> using __call__ = T; };
+    struct Second { template <class T> using __call__ = argpass::at<T, 1>; };
+    struct a {};
+    struct b {};
+    struct c {};
+    struct d {};
+    static_assert(std::is_same_v<argpass::sort<Argpass<long, char, int, char[3], short>, SizeOf>, Argpass<char, short, char[3], int, long>>, "sort works correctly");
+    static_assert(std::is_same_v<argpass::sort<Argpass<_3, _1, _4, _1, _5, _0, _2, _6>, Self>, Argpass<_0, _1, _1, _2, _3, _4, _5, _6>>, "sort works with peano keys");
+    static_assert(std::is_same_v<
+        argpass::sort<Argpass<Argpass<a, _2>, Argpass<b, _1>, Argpass<c, _2>, Argpass<d, _1>>, Second>,
+        Argpass<Argpass<b, _1>, Argpass<d, _1>, Argpass<a, _2>, Argpass<c, _2>>
+    >, "sort is stable");
+    static_assert(std::is_same_v<argpass::sort<Argpass<long>, SizeOf>, Argpass<long>>, "sort works on one element");
+    static_assert(std::is_same_v<argpass::sort<Argpass<_2>, Self>, Argpass<_2>>, "sort works on one element");
+    static_assert(std::is_same_v<
+        argpass::sort<Argpass<Num<5>, _3, Num<-1>, _4>, Self>,
+        Argpass<Num<-1>, _3, _4, Num<5>>
+    >, "sort works with a mix of Nums and peano keys");
+    static_assert(std::is_same_v<
+        argpass::sort<Argpass<binary::Integer<1ull << 40>, _3, binary::Integer<1000>>, Self>,
+        Argpass<_3, binary::Integer<1000>, binary::Integer<1ull << 40>>
+    >, "sort works with binary keys up to 64 bits");
+    static_assert(std::is_same_v<argpass::sort<Argpass<>, Self>, Argpass<>>, "sort works correctly");
+
+    struct AddPointer { template <class T> using __call__ = T*; };
+    struct IsPeano { template <class T> using __call__ = peano::is_peano_integer<T>; };
+    struct Add { template <class Acc, class T> using __call__ = peano::add<Acc, T>; };
+    struct Push { template <class Acc, class T> using __call__ = Argpass<T, Acc>; };
+    static_assert(std::is_same_v<argpass::map<AddPointer, Argpass<int, char, void>>, Argpass<int*, char*, void*>>, "map works correctly");
+    static_assert(std::is_same_v<argpass::map<AddPointer, Argpass<>>, Argpass<>>, "map works correctly");
+    static_assert(std::is_same_v<argpass::filter<IsPeano, Argpass<_1, int, _2, void, char, _3>>, Argpass<_1, _2, _3>>, "filter works correctly");
+    static_assert(std::is_same_v<argpass::foldl<Add, _0, Argpass<_1, _2, _3, _4>>, _10>, "foldl works correctly");
+    static_assert(std::is_same_v<argpass::foldl<Push, void, Argpass<int, char>>, Argpass<char, Argpass<int, void>>>, "foldl folds from the left");
+    static_assert(std::is_same_v<argpass::foldl<Push, void, Argpass<>>, void>, "foldl of nothing is Init");
+    static_assert(std::is_same_v<argpass::zip<Argpass<int, char>, Argpass<_1, _2>>, Argpass<Argpass<int, _1>, Argpass<char, _2>>>, "zip works correctly");
+    static_assert(std::is_same_v<argpass::enumerate<Argpass<int, char>>, Argpass<Argpass<Num<std::size_t(0)>, int>, Argpass<Num<std::size_t(1)>, char>>>, "enumerate works correctly");
+
+    // Walking over a list by index
+    using Primes = Argpass<Num<2>, Num<3>, Num<5>, Num<7>, Num<11>, Num<13>, Num<17>, Num<19>, Num<23>, Num<29>, Num<31>, Num<37>>;
+
+    struct i {};
+    struct total {};
+    struct cond {};
+    run_line : Assign_v<i, 0, RE> {};
+    run_line : Assign_v<total, 0, RE> {};
+    run_line : Assign<cond, True, RE> {};
+
+    struct SumPrimes {
+        template <class _>
+        struct __call__ :
+            Assign<total, add<total, argpass::at<Primes, value_v<i, RE>>, RE>, RE>,
+            Assign<i, add<i, Num<1>, RE>, RE>,
+            Assign<cond, leq<i, Num<9>, RE>, RE>
+        {};
+    };
+
+    run_line : DoWhile<SumPrimes, cond, RE> {};
+
+    // the first 10 primes, GCC runs an additional step
+#ifdef __clang__
+    static_assert(value_v<total, RE> == 129);
+#elif __GNUG__
+    static_assert(value_v<total, RE> == 160);
+#endif
+};
+
+namespace for_each_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct list {};
+    struct total {};
+    run_line : Assign<list, Argpass<>, RE> {};
+    run_line : Assign_v<total, 0, RE> {};
+
+    struct Append {
+        template <class Elem, class _>
+        struct __call__ : Assign<list, argpass::concat<value<list, RE>, Argpass<Elem>>, RE> {};
+    };
+    struct AddToTotal {
+        template <class Elem, class _>
+        struct __call__ : Assign<total, add<mult<total, Num<10>, RE>, Elem, RE>, RE> {};
+    };
+
+    // the calls are in list order because GCC instantiates the base classes left to right
+    run_line : ForEach<Append, Argpass<_3, _1, _4, _1, _5>, RE> {};
+#ifndef __clang__
+    static_assert(std::is_same_v<value<list, RE>, Argpass<_3, _1, _4, _1, _5>>, "ForEach calls the function on each element in order");
+#else
+    static_assert(value<list, RE>::size == 5, "ForEach calls the function on each element");
+#endif
+
+    run_line : ForEach<AddToTotal, Argpass<_3, _1, _4, _1, _5, _9, _2, _6>, RE> {};
+#ifndef __clang__
+    static_assert(value_v<total, RE> == 31415926, "ForEach calls the function on each element in order");
+#else
+    static_assert(value_v<total, RE> >= 10000000, "ForEach calls the function on each element");
+#endif
+
+    struct before {};
+    run_line : Assign<before, value<list, RE>, RE> {};
+    run_line : ForEach<Append, Argpass<>, RE> {};
+    static_assert(std::is_same_v<value<list, RE>, value<before, RE>>, "ForEach over nothing does nothing");
+
+    run_line : ForEach<Assignment<list>, Argpass<int, char>, RE> {};
+    static_assert(std::is_same_v<value<list, RE>, char>, "ForEach works with Assignment");
+};
+
+namespace array_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct arr {};
+    run_line : ArraySet<arr, 3, int, RE> {};
+    run_line : ArraySet<arr, 1000, char, RE> {};
+    run_line : ArraySet<arr, 3, float, RE> {};
+    static_assert(std::is_same_v<ArrayGet<arr, 3, RE>, float>, "ArraySet and ArrayGet work correctly");
+    static_assert(std::is_same_v<ArrayGet<arr, 1000, RE>, char>, "ArraySet and ArrayGet work correctly");
+    static_assert(std::is_same_v<ArrayGet<arr, 4, RE>, None>, "unset elements are None");
+    static_assert(array_length<arr, RE> == 0, "ArraySet doesn't change the length");
+
+    struct vec {};
+    run_line : ArrayPushBack<vec, int, RE> {};
+    run_line : ArrayPushBack<vec, char, RE> {};
+    run_line : ArrayPushBack<vec, _5, RE> {};
+    static_assert(array_length<vec, RE> == 3, "ArrayPushBack increments the length");
+    static_assert(std::is_same_v<ArrayGet<vec, 0, RE>, int>, "ArrayPushBack works correctly");
+    static_assert(std::is_same_v<ArrayGet<vec, 2, RE>, _5>, "ArrayPushBack works correctly");
+    run_line : ArrayResize<vec, 1, RE> {};
+    run_line : ArrayPushBack<vec, void, RE> {};
+    static_assert(std::is_same_v<ArrayGet<vec, 1, RE>, void>, "ArrayResize works correctly");
+    static_assert(array_length<vec, RE> == 2, "ArrayResize works correctly");
+
+    // Sieve of Eratosthenes, the composite cells are set to True
+    constexpr unsigned N = 1000;
+    struct sieve {};
+
+    template <unsigned p, class Ks>
+    struct MultiplesImpl {};
+    template <unsigned p, unsigned ... Ks>
+    struct MultiplesImpl<p, std::integer_sequence<unsigned, Ks...>> {
+        using value = Argpass<Num<p * (Ks + p)>...>;
+    };
+    // the multiples p*p, p*(p+1), ... below N
+    template <unsigned p>
+    using Multiples = typename MultiplesImpl<p, std::make_integer_sequence<unsigned, (p * p < N ? (N - 1) / p - p + 1 : 0)>>::value;
+
+    struct MarkComposite {
+        template <class Elem, class _>
+        struct __call__ : ArraySet<sieve, Elem::value, True, RE> {};
+    };
+    struct MarkAll {
+        template <class List, class _>
+        struct __call__ : ForEach<MarkComposite, List, RE> {};
+    };
+    struct SieveStep {
+        template <class Elem, class _>
+        struct __call__ : if_<is_same<ArrayGet<sieve, Elem::value, RE>, None>, MarkAll, Multiples<Elem::value>, RE> {};
+    };
+
+    template <class Is>
+    struct CandidatesImpl {};
+    template <unsigned ... Is>
+    struct CandidatesImpl<std::integer_sequence<unsigned, Is...>> {
+        using value = Argpass<Num<Is + 2>...>;
+    };
+    // only the primes up to sqrt(N) mark anything
+    using Candidates = typename CandidatesImpl<std::make_integer_sequence<unsigned, 30>>::value;
+
+    run_line : ForEach<SieveStep, Candidates, RE> {};
+
+    static_assert(std::is_same_v<ArrayGet<sieve, 997, RE>, None>, "997 is prime");
+    static_assert(std::is_same_v<ArrayGet<sieve, 991, RE>, None>, "991 is prime");
+    static_assert(std::is_same_v<ArrayGet<sieve, 961, RE>, True>, "961 = 31 * 31 is composite");
+    static_assert(std::is_same_v<ArrayGet<sieve, 989, RE>, True>, "989 = 23 * 43 is composite");
+    static_assert(std::is_same_v<ArrayGet<sieve, 512, RE>, True>, "512 is composite");
+};
+
+namespace dict_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct dict {};
+    struct other {};
+    run_line : DictSet<dict, int, float, RE> {};
+    run_line : DictSet<dict, char, _5, RE> {};
+    run_line : DictSet<dict, int, double, RE> {};
+    run_line : DictSet<dict, void, None, RE> {};
+    run_line : DictSet<other, int, bool, RE> {};
+
+    static_assert(std::is_same_v<DictGet<dict, int, RE>, double>, "DictSet and DictGet work correctly");
+    static_assert(std::is_same_v<DictGet<dict, char, RE>, _5>, "DictSet and DictGet work correctly");
+    static_assert(std::is_same_v<DictGet<dict, long, RE>, None>, "missing keys are None");
+    static_assert(std::is_same_v<DictGet<other, int, RE>, bool>, "dicts are independent");
+    static_assert(std::is_same_v<DictContains<dict, void, RE>, True>, "keys set to None are still contained");
+    static_assert(std::is_same_v<DictContains<dict, long, RE>, False>, "DictContains works correctly");
+    static_assert(std::is_same_v<dict_keys<dict, RE>, Argpass<int, char, void>>, "dict_keys lists the keys in insertion order");
+    static_assert(std::is_same_v<dict_keys<other, RE>, Argpass<int>>, "dict_keys works correctly");
+
+    // Memoized fibonacci, the dict maps n to fib(n)
+    struct fib {};
+    run_line : DictSet<fib, Num<0u>, Num<0ull>, RE> {};
+    run_line : DictSet<fib, Num<1u>, Num<1ull>, RE> {};
+
+    struct FibStep {
+        template <class Elem, class _>
+        struct __call__ : DictSet<
+            fib, Elem, 
+            add<DictGet<fib, Num<Elem::value - 1u>, RE>, DictGet<fib, Num<Elem::value - 2u>, RE>, RE>, 
+            RE
+        > {};
+    };
+    template <class Is>
+    struct RangeImpl {};
+    template <unsigned ... Is>
+    struct RangeImpl<std::integer_sequence<unsigned, Is...>> {
+        using value = Argpass<Num<Is + 2u>...>;
+    };
+    run_line : ForEach<FibStep, typename RangeImpl<std::make_integer_sequence<unsigned, 79>>::value, RE> {};
+
+    static_assert(DictGet<fib, Num<80u>, RE>::value == 23416728348467685ull, "fib(80) is computed with memoization");
+    static_assert(argpass::size<dict_keys<fib, RE>> == 81, "dict_keys works correctly");
+};
+
+namespace deque_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct dq {};
+    static_assert(std::is_same_v<Empty<dq, RE>, True>, "a new deque is empty");
+    run_line : PushBack<dq, int, RE> {};
+    run_line : PushBack<dq, char, RE> {};
+    run_line : PushFront<dq, void, RE> {};
+    static_assert(deque_size<dq, RE> == 3, "deque_size works correctly");
+    static_assert(std::is_same_v<Front<dq, RE>, void>, "PushFront works correctly");
+    static_assert(std::is_same_v<Back<dq, RE>, char>, "PushBack works correctly");
+    run_line : PopBack<dq, RE> {};
+    static_assert(std::is_same_v<Back<dq, RE>, int>, "PopBack works correctly");
+    run_line : PopFront<dq, RE> {};
+    static_assert(std::is_same_v<Front<dq, RE>, int>, "PopFront works correctly");
+    run_line : PopFront<dq, RE> {};
+    static_assert(std::is_same_v<Empty<dq, RE>, True>, "the deque is empty again");
+    static_assert(std::is_same_v<Front<dq, RE>, None>, "Front of a deque emptied by pops is None");
+    static_assert(std::is_same_v<Back<dq, RE>, None>, "Back of a deque emptied by pops is None");
+
+    // Breadth-first search, every node is popped exactly once
+    template <class Node> struct Neighbors { using value = Argpass<>; };
+    template <> struct Neighbors<Num<0>> { using value = Argpass<Num<1>, Num<2>>; };
+    template <> struct Neighbors<Num<1>> { using value = Argpass<Num<3>, Num<0>>; };
+    template <> struct Neighbors<Num<2>> { using value = Argpass<Num<4>, Num<5>, Num<1>>; };
+    template <> struct Neighbors<Num<3>> { using value = Argpass<Num<6>>; };
+    template <> struct Neighbors<Num<5>> { using value = Argpass<Num<6>, Num<7>>; };
+
+    struct queue {};
+    struct visited {};
+    struct order {};
+
+    struct Enqueue {
+        template <class V, class _>
+        struct __call__ : DictSet<visited, V, True, RE>, PushBack<queue, V, RE> {};
+    };
+    struct EnqueueIfNew {
+        template <class V, class _>
+        struct __call__ : if_<Not<DictContains<visited, V, RE>, RE>, Enqueue, V, RE> {};
+    };
+    template <class U, class _>
+    struct VisitNode :
+        PopFront<queue, RE>,
+        ArrayPushBack<order, U, RE>,
+        ForEach<EnqueueIfNew, typename Neighbors<U>::value, RE>
+    {};
+    struct Visit {
+        template <class Elem, class _>
+        struct __call__ : VisitNode<Front<queue, RE>, RE> {};
+    };
+
+    run_line : Enqueue::__call__<Num<0>, RE> {};
+    using Steps = Argpass<int, int, int, int, int, int, int, int>;
+    run_line : ForEach<Visit, Steps, RE> {};
+
+    static_assert(std::is_same_v<
+        Argpass<ArrayGet<order, 0, RE>, ArrayGet<order, 1, RE>, ArrayGet<order, 2, RE>, ArrayGet<order, 3, RE>, 
+                ArrayGet<order, 4, RE>, ArrayGet<order, 5, RE>, ArrayGet<order, 6, RE>, ArrayGet<order, 7, RE>>,
+        Argpass<Num<0>, Num<1>, Num<2>, Num<3>, Num<4>, Num<5>, Num<6>, Num<7>>
+    >, "the nodes are visited in breadth-first order");
+    static_assert(std::is_same_v<Empty<queue, RE>, True>, "the queue is empty after the search");
+};
+
+namespace record_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct x {};
+    struct y {};
+    struct z {};
+    struct point : Record<x, y, z> {};
+    struct other : Record<x> {};
+
+    run_line : FieldSet<point, x, _1, RE> {};
+    run_line : FieldSet<point, y, _2, RE> {};
+    run_line : FieldSet<other, x, int, RE> {};
+    static_assert(std::is_same_v<FieldGet<point, x, RE>, _1>, "FieldSet and FieldGet work correctly");
+    static_assert(std::is_same_v<FieldGet<point, z, RE>, None>, "unset fields are None");
+    static_assert(std::is_same_v<FieldGet<other, x, RE>, int>, "records are independent");
+
+    using saved = record_snapshot<point, RE>;
+    static_assert(std::is_same_v<saved, Argpass<_1, _2, None>>, "record_snapshot works correctly");
+    run_line : FieldSet<point, x, _7, RE> {};
+    run_line : FieldSet<point, z, _3, RE> {};
+    static_assert(std::is_same_v<record_snapshot<point, RE>, Argpass<_7, _2, _3>>, "record_snapshot works correctly");
+    run_line : RecordRestore<point, saved, RE> {};
+    static_assert(std::is_same_v<record_snapshot<point, RE>, Argpass<_1, _2, None>>, "RecordRestore works correctly");
+
+    // The Collatz sequence of 3637 with its state in a record, a step does nothing once a reaches 1
+    struct a {};
+    struct steps {};
+    struct collatz : Record<a, steps> {};
+    run_line : FieldSet<collatz, a, Num<3637u>, RE> {};
+    run_line : FieldSet<collatz, steps, Num<0u>, RE> {};
+
+    using Next = decltype([](unsigned n) { return n % 2 == 0 ? n / 2 : 3 * n + 1; });
+    struct Advance {
+        template <class A, class _>
+        struct __call__ :
+            FieldSet<collatz, a, apply_constexpr<Next, A, RE>, RE>,
+            FieldSet<collatz, steps, add<FieldGet<collatz, steps, RE>, Num<1u>, RE>, RE>
+        {};
+    };
+    struct CollatzStep {
+        template <class Elem, class _>
+        struct __call__ : if_<
+            Not<eq<FieldGet<collatz, a, RE>, Num<1u>, RE>, RE>, 
+            Advance, FieldGet<collatz, a, RE>, RE
+        > {};
+    };
+    run_line : ForEach<CollatzStep, Argpass<int, int, int, int, int, int, int, int, int, int, int, int, int, int, int, int, int, int, int, int>, RE> {};
+
+    static_assert(std::is_same_v<record_snapshot<collatz, RE>, Argpass<Num<1u>, Num<17u>>>, "3637 reaches 1 in 17 steps");
+};
+
+namespace node_heap_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct my_heap {};
+    using h0 = Alloc<RE>;
+    using h1 = Alloc<RE>;
+    using h2 = Alloc<RE, my_heap>;
+    static_assert(!std::is_same_v<h0, h1>, "Alloc returns fresh handles");
+    static_assert(h2::value == 0, "heaps number their handles independently");
+    static_assert(!std::is_same_v<h0, h2>, "the handles of separate heaps differ");
+    struct field {};
+    run_line : NodeSet<h2, field, int, RE> {};
+    static_assert(std::is_same_v<NodeGet<h0, field, RE>, None>, "the nodes of separate heaps don't share fields");
+
+    // Union-find with path compression
+    struct parent {};
+
+    template <class X, class _, class P = NodeGet<X, parent, _>>
+    struct Find : NodeSet<X, parent, typename Find<P, _>::root, RE> {
+        using root = typename Find<P, _>::root;
+    };
+    template <class X, class _>
+    struct Find<X, _, X> {
+        using root = X;
+    };
+
+    template <class X, class Y, class _, class RX = typename Find<X, _>::root, class RY = typename Find<Y, _>::root>
+    struct Union : NodeSet<RX, parent, RY, RE> {};
+    template <class X, class Y, class _, class R>
+    struct Union<X, Y, _, R, R> {};
+
+    struct MakeSet {
+        template <class H, class _>
+        struct __call__ : NodeSet<H, parent, H, RE> {};
+    };
+
+    using n0 = Alloc<RE>;
+    using n1 = Alloc<RE>;
+    using n2 = Alloc<RE>;
+    using n3 = Alloc<RE>;
+    using n4 = Alloc<RE>;
+    using n5 = Alloc<RE>;
+    run_line : ForEach<MakeSet, Argpass<n0, n1, n2, n3, n4, n5>, RE> {};
+
+    run_line : Union<n0, n1, RE> {};
+    run_line : Union<n1, n2, RE> {};
+    run_line : Union<n2, n3, RE> {};
+    run_line : Union<n4, n5, RE> {};
+
+    // the chain n0 -> n1 -> n2 -> n3 before the compression
+    static_assert(std::is_same_v<NodeGet<n0, parent, RE>, n1>, "Union links the roots");
+    static_assert(std::is_same_v<typename Find<n0, RE>::root, n3>, "Find follows the parents to the root");
+    static_assert(std::is_same_v<NodeGet<n0, parent, RE>, n3>, "Find compresses the path");
+    static_assert(std::is_same_v<NodeGet<n1, parent, RE>, n3>, "Find compresses the path");
+    static_assert(std::is_same_v<typename Find<n5, RE>::root, n5>, "the sets are separate");
+    static_assert(!std::is_same_v<typename Find<n4, RE>::root, typename Find<n2, RE>::root>, "the sets are separate");
+};
+
+namespace ordered_map_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct m : OrderedMap<16> {};
+
+    run_line : MapInsert<m, Num<40>, int, RE> {};
+    run_line : MapInsert<m, peano::_5, char, RE> {};
+    run_line : MapInsert<m, Num<17u>, float, RE> {};
+    run_line : MapInsert<m, binary::Integer<1000>, bool, RE> {};
+    run_line : MapInsert<m, Num<5>, double, RE> {};
+
+    static_assert(std::is_same_v<MapFind<m, Num<40>, RE>, int>, "MapFind reads the value of the key");
+    static_assert(std::is_same_v<MapFind<m, peano::Integer<17>, RE>, float>, "the keys are compared by value");
+    static_assert(std::is_same_v<MapFind<m, Num<5>, RE>, double>, "MapInsert overwrites the value");
+    static_assert(std::is_same_v<MapFind<m, Num<6>, RE>, None>, "missing keys are None");
+
+    static_assert(std::is_same_v<MapLowerBound<m, Num<0>, RE>, peano::_5>, "the keys keep their inserted type");
+    static_assert(std::is_same_v<MapLowerBound<m, Num<6>, RE>, Num<17u>>, "MapLowerBound finds the next key");
+    static_assert(std::is_same_v<MapLowerBound<m, Num<40>, RE>, Num<40>>, "MapLowerBound includes the key itself");
+    static_assert(std::is_same_v<MapLowerBound<m, Num<41>, RE>, binary::Integer<1000>>, "MapLowerBound crosses subtrees");
+    static_assert(std::is_same_v<MapLowerBound<m, Num<1001>, RE>, None>, "there is no key after the last one");
+
+    static_assert(std::is_same_v<
+        map_range<m, Num<0>, Num<65535>, RE>,
+        Argpass<peano::_5, Num<17u>, Num<40>, binary::Integer<1000>>
+    >, "map_range lists the keys in order");
+    static_assert(std::is_same_v<map_range<m, Num<6>, Num<40>, RE>, Argpass<Num<17u>>>, "map_range excludes the upper bound");
+    static_assert(std::is_same_v<map_range<m, Num<41>, Num<2000>, RE>, Argpass<binary::Integer<1000>>>, "map_range crosses subtrees");
+    static_assert(std::is_same_v<map_range<m, Num<40>, Num<40>, RE>, Argpass<>>, "an empty range has no keys");
+    static_assert(std::is_same_v<map_range<m, Num<1001>, Num<65535>, RE>, Argpass<>>, "there are no keys after the last one");
+
+    struct wide : OrderedMap<32> {};
+    run_line : MapInsert<wide, Num<70000>, int, RE> {};
+    static_assert(std::is_same_v<MapFind<wide, Num<70000>, RE>, int>, "int keys work in a 32-bit map");
+
+    // MapKey static_asserts these
+    static_assert(containers::key_fits<m, binary::Integer<65535>>, "the largest key fits");
+    static_assert(!containers::key_fits<m, binary::Integer<65536>>, "a key of 17 bits doesn't fit in a 16-bit map");
+    static_assert(!containers::key_fits<m, Num<-1>>, "a negative key doesn't fit");
+    static_assert(!containers::key_fits<wide, binary::add<binary::Integer<~0ull>, binary::Integer<6>>>, 
+        "2^64 + 5 doesn't fit, instead of aliasing 5");
+
+    // Insert scattered keys, then read them back sorted
+    struct scattered : OrderedMap<16> {};
+    template <unsigned i>
+    using key = Num<(i * 7919u) % 65521u>;
+
+    template <class Is>
+    struct KeysImpl {};
+    template <unsigned ... Is>
+    struct KeysImpl<std::integer_sequence<unsigned, Is...>> {
+        using value = Argpass<key<Is>...>;
+    };
+    using keys = typename KeysImpl<std::make_integer_sequence<unsigned, 30>>::value;
+
+    struct InsertKey {
+        template <class K, class _>
+        struct __call__ : MapInsert<scattered, K, K, RE> {};
+    };
+    run_line : ForEach<InsertKey, keys, RE> {};
+
+    struct ByValue {
+        template <class T>
+        using __call__ = T;
+    };
+    static_assert(std::is_same_v<
+        map_range<scattered, Num<0>, Num<65535>, RE>, 
+        argpass::sort<keys, ByValue>
+    >, "map_range sorts the keys");
+    static_assert(std::is_same_v<MapFind<scattered, key<20>, RE>, key<20>>, "MapFind works correctly");
+};
+
+namespace priority_queue_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct q {};
+    static_assert(std::is_same_v<Top<q, RE>, None>, "an empty queue has no top");
+
+    run_line : Push<q, peano::_3, char, RE> {};
+    run_line : Push<q, Num<1>, int, RE> {};
+    run_line : Push<q, binary::Integer<2>, float, RE> {};
+    static_assert(std::is_same_v<Top<q, RE>, int>, "Top is the value with the smallest priority");
+    static_assert(std::is_same_v<TopPriority<q, RE>, Num<1>>, "TopPriority is the smallest priority");
+    run_line : PopMin<q, RE> {};
+    static_assert(std::is_same_v<Top<q, RE>, float>, "the priorities of all kinds are compared");
+    static_assert(heap_size<q, RE> == 2, "PopMin removes one entry");
+    run_line : PopMin<q, RE> {};
+    run_line : PopMin<q, RE> {};
+    static_assert(std::is_same_v<Top<q, RE>, None>, "a queue emptied by PopMin has no top");
+    static_assert(std::is_same_v<TopPriority<q, RE>, None>, "a queue emptied by PopMin has no top");
+
+    // Heap sort: push scattered priorities, then pop them all in order
+    struct h {};
+    struct sorted {};
+    template <unsigned i>
+    using priority = Num<(i * 37u) % 101u>;
+
+    template <class Is>
+    struct PrioritiesImpl {};
+    template <unsigned ... Is>
+    struct PrioritiesImpl<std::integer_sequence<unsigned, Is...>> {
+        using value = Argpass<priority<Is>...>;
+    };
+    using priorities = typename PrioritiesImpl<std::make_integer_sequence<unsigned, 30>>::value;
+
+    struct PushPriority {
+        template <class P, class _>
+        struct __call__ : Push<h, P, P, RE> {};
+    };
+    run_line : ForEach<PushPriority, priorities, RE> {};
+
+    struct PopToArray {
+        template <class P, class _>
+        struct __call__ : ArrayPushBack<sorted, Top<h, RE>, RE>, PopMin<h, RE> {};
+    };
+    run_line : ForEach<PopToArray, priorities, RE> {};
+
+    template <class Is>
+    struct SortedImpl {};
+    template <unsigned ... Is>
+    struct SortedImpl<std::integer_sequence<unsigned, Is...>> {
+        using value = Argpass<ArrayGet<sorted, Is, RE>...>;
+    };
+    struct ByValue {
+        template <class T>
+        using __call__ = T;
+    };
+    static_assert(std::is_same_v<
+        typename SortedImpl<std::make_integer_sequence<unsigned, 30>>::value, 
+        argpass::sort<priorities, ByValue>
+    >, "PopMin pops the entries in the order of their priorities");
+    static_assert(heap_size<h, RE> == 0, "the heap is empty in the end");
+};
+
+namespace cons_list_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+    using argpass::Cons;
+    using argpass::Nil;
+
+    template <class> struct __run_line {};
+
+    static_assert(std::is_same_v<argpass::from_argpass<Argpass<int, char>>, Cons<int, Cons<char, Nil>>>, "from_argpass works correctly");
+    static_assert(std::is_same_v<argpass::from_argpass<Argpass<>>, Nil>, "from_argpass works correctly");
+    static_assert(std::is_same_v<argpass::to_argpass<Cons<int, Cons<char, Nil>>>, Argpass<int, char>>, "to_argpass works correctly");
+    static_assert(std::is_same_v<argpass::to_argpass<Nil>, Argpass<>>, "to_argpass works correctly");
+
+    template <class Is>
+    struct RangeImpl {};
+    template <unsigned ... Is>
+    struct RangeImpl<std::integer_sequence<unsigned, Is...>> {
+        using value = Argpass<Num<Is>...>;
+    };
+    using range = typename RangeImpl<std::make_integer_sequence<unsigned, 1003>>::value;
+    static_assert(std::is_same_v<argpass::to_argpass<argpass::from_argpass<range>>, range>, "the conversions are inverse");
+
+    // A list longer than the template depth, built in halves: Num<o>, ..., Num<o + 2^k - 1> in front of L
+    template <unsigned k, unsigned o, class L>
+    struct Prefix {
+        using value = typename Prefix<k - 1, o, typename Prefix<k - 1, o + (1u << (k - 1)), L>::value>::value;
+    };
+    template <unsigned o, class L>
+    struct Prefix<0, o, L> {
+        using value = Cons<Num<o>, L>;
+    };
+    using long_range = typename RangeImpl<std::make_integer_sequence<unsigned, 1u << 14>>::value;
+    static_assert(std::is_same_v<argpass::to_argpass<typename Prefix<14, 0, Nil>::value>, long_range>, "to_argpass is O(log n) deep");
+
+    // Grow a list in a variable, each step shares the previous list
+    struct lst {};
+    run_line : Assign<lst, Nil, RE> {};
+    struct Prepend {
+        template <class T, class _>
+        struct __call__ : Assign<lst, Cons<T, value<lst, RE>>, RE> {};
+    };
+    run_line : ForEach<Prepend, Argpass<int, char, float>, RE> {};
+    static_assert(std::is_same_v<value<lst, RE>, Cons<float, Cons<char, Cons<int, Nil>>>>, "Cons prepends to the list");
+    static_assert(std::is_same_v<typename value<lst, RE>::tail::head, char>, "the tail is shared");
+};
+
+namespace generator_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct CountUp {
+        template <class N>
+        struct __call__ {
+            using value = N;
+            using next = peano::Succ<N>;
+        };
+    };
+    struct naturals : Generator<peano::Zero, CountUp> {};
+
+    static_assert(std::is_same_v<NextValue<naturals, RE>, peano::Zero>, "the first element comes from the initial state");
+    static_assert(std::is_same_v<NextValue<naturals, RE>, peano::_1>, "NextValue advances the generator");
+    static_assert(std::is_same_v<NextValue<naturals, RE>, peano::_2>, "NextValue advances the generator");
+
+    // An infinite stream of primes, of which only a prefix is consumed
+    constexpr unsigned next_prime(unsigned n) {
+        for (;; ++n) {
+            bool prime = n >= 2;
+            for (unsigned d = 2; d * d <= n && prime; ++d) {
+                prime = n % d != 0;
+            }
+            if (prime) return n;
+        }
+    }
+    struct PrimeStep {
+        template <class N>
+        struct __call__ {
+            using value = Num<next_prime(N::value)>;
+            using next = Num<value::value + 1>;
+        };
+    };
+    struct primes : Generator<Num<0u>, PrimeStep> {};
+
+    struct tenth {};
+    struct Pull {
+        template <class T, class _>
+        struct __call__ : Assign<tenth, NextValue<primes, _>, _> {};
+    };
+    run_line : ForEach<Pull, Argpass<int[1], int[2], int[3], int[4], int[5], int[6], int[7], int[8], int[9], int[10]>, RE> {};
+    static_assert(std::is_same_v<value<tenth, RE>, Num<29u>>, "the tenth prime is 29");
+    static_assert(std::is_same_v<NextValue<primes, RE>, Num<31u>>, "the generator resumes where it stopped");
+
+    // None is an ordinary state, it doesn't restart the generator
+    struct Toggle {
+        template <class S>
+        struct __call__ {
+            using value = S;
+            using next = conditional_using<std::is_same_v<S, None>, True, None>;
+        };
+    };
+    struct toggle : Generator<True, Toggle> {};
+    static_assert(std::is_same_v<NextValue<toggle, RE>, True>, "the first element comes from the initial state");
+    static_assert(std::is_same_v<NextValue<toggle, RE>, None>, "a step can produce None");
+    static_assert(std::is_same_v<NextValue<toggle, RE>, True>, "the state None is kept");
+    static_assert(std::is_same_v<NextValue<toggle, RE>, None>, "the state None is kept");
+};
+
+namespace bitset_test {
+    using namespace type_var;
+    using namespace ctstd;
+    using namespace cexpr_control;
+    using argpass::Argpass;
+
+    template <class> struct __run_line {};
+
+    struct b : PackedBits<200> {};
+    run_line : BitSet<b, 3, RE> {};
+    run_line : BitSet<b, 130, RE> {};
+    run_line : BitSet<b, 199, RE> {};
+    run_line : BitSet<b, 3, RE> {};
+    static_assert(std::is_same_v<BitTest<b, 3, RE>, True>, "BitSet sets the bit");
+    static_assert(std::is_same_v<BitTest<b, 4, RE>, False>, "BitSet sets only that bit");
+    static_assert(std::is_same_v<Popcount<b, RE>, Num<3u>>, "Popcount counts the set bits");
+    run_line : BitClear<b, 130, RE> {};
+    static_assert(std::is_same_v<BitTest<b, 130, RE>, False>, "BitClear clears the bit");
+    static_assert(std::is_same_v<Popcount<b, RE>, Num<2u>>, "Popcount counts the set bits");
+
+    // Sieve of Eratosthenes, each prime marks its multiples one word at a time
+    constexpr unsigned N = 1024;
+    struct composite : PackedBits<N> {};
+
+    constexpr unsigned long long multiples(unsigned p, unsigned w) {
+        unsigned long long mask = 0;
+        for (unsigned j = 0; j < 64; ++j) {
+            unsigned n = 64 * w + j;
+            if (n >= p * p && n % p == 0) mask |= 1ull << j;
+        }
+        return mask;
+    }
+
+    template <class P, class Ws, class _>
+    struct MarkMultiples {};
+    template <class P, unsigned ... ws, class _>
+    struct MarkMultiples<P, std::integer_sequence<unsigned, ws...>, _> :
+        BitSetWord<composite, ws, multiples(P::value, ws), _>...
+    {};
+
+    template <class P, class _, class IsComposite = BitTest<composite, P::value, _>>
+    struct Sift : MarkMultiples<P, std::make_integer_sequence<unsigned, composite::words>, _> {};
+    template <class P, class _>
+    struct Sift<P, _, True> {};
+
+    struct SiftStep {
+        template <class P, class _>
+        struct __call__ : Sift<P, _> {};
+    };
+
+    template <class Is>
+    struct CandidatesImpl {};
+    template <unsigned ... Is>
+    struct CandidatesImpl<std::integer_sequence<unsigned, Is...>> {
+        using value = Argpass<Num<Is + 2u>...>;
+    };
+    run_line : BitSetWord<composite, 0, 0b11, RE> {};
+    run_line : ForEach<SiftStep, typename CandidatesImpl<std::make_integer_sequence<unsigned, 31>>::value, RE> {};
+
+    static_assert(std::is_same_v<BitTest<composite, 1021, RE>, False>, "1021 is prime");
+    static_assert(std::is_same_v<BitTest<composite, 1007, RE>, True>, "1007 = 19 * 53 is composite");
+    static_assert(N - Popcount<composite, RE>::value == 172, "there are 172 primes below 1024");
+};
+
 
 
 namespace random_fun_tests {
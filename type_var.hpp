@@ -81,21 +81,45 @@ namespace type_var {
             return assign_reader<T, Val, N+1, _>(int{});
         }
 
-        // If the flag(Flag<T, N>) doesn't exist, return None
+        // The number of flags of T defined so far, the topmost one is flag(Flag<T, N-1>)
+        template <int N>
+        struct FlagCount {
+            static constexpr int value = N;
+        };
+
+        // If the flag(Flag<T, N>) doesn't exist, there are N flags
+        // The count is returned as a type, so it is computed in an unevaluated context only
         template <class, int N = 0, class _>
-        constexpr auto load_reader(float) {
-            return Container<ctstd::None, _>{};
+        constexpr auto flag_count(float) {
+            return FlagCount<N>{};
         }
-        // If the this is the last N with well-formed flag, return the value encoded in it, otherwise go to N+1
+        // If flag(Flag<T, N>) exists, pass to N+1
         template <
             class T, int N = 0,
             class _,
-            class U = decltype(flag(Flag<T, N>{}))
+            class = decltype(flag(Flag<T, N>{}))
         >
-        constexpr auto load_reader(int) {
-            using Res = decltype(load_reader<T, N+1, _>(int{}));
-            return ctstd::conditional_using<std::is_same_v<Res, Container<ctstd::None, _>>, U, Res>{};
+        constexpr auto flag_count(int) {
+            return decltype(flag_count<T, N+1, _>(int{})){};
         }
+
+        // Thunk for the value encoded in flag(Flag<T, N>)
+        template <class T, int N>
+        struct FlagValue {
+            using value = decltype(flag(Flag<T, N>{}));
+        };
+
+        // The value encoded in the topmost flag, or None if there are no flags
+        // Only the chosen branch is instantiated, so FlagValue<T, -1> is never formed
+        template <class T, class _>
+        struct load_reader {
+            static constexpr int N = decltype(flag_count<T, 0, _>(int{}))::value;
+            using value = ctstd::lazy_if<
+                N == 0, 
+                ctstd::Identity<Container<ctstd::None, _>>, 
+                FlagValue<T, N - 1>
+            >;
+        };
     };
     
     /// Core assignment primitive: stores the value Val in the type variable T
@@ -116,6 +140,14 @@ namespace type_var {
     >
     struct Assign : _ {};
 
+    /// Assignment of a native value: stores ctstd::Num<V> in the type variable T
+    /// The arithmetic in ctstd works on the stored Num natively
+    /// 
+    /// Usage: struct assignment : Assign_v<variable_name, 42, RE> {};
+    /// After instantiation, value_v<variable_name, RE> == 42
+    template <class T, auto V, class _>
+    using Assign_v = Assign<T, ctstd::Num<V>, _>;
+
     /// Function object wrapper for delayed assignment operations
     /// Creates a callable template that can be used with control flow primitives
     /// like if_, if_else, and loop constructs that expect function objects.
@@ -151,7 +183,14 @@ namespace type_var {
     /// Usage: using current_value = value<variable_name, RE>;
     template <
         class T, class _ = decltype([](){}),
-        class R = typename decltype(friend_injection::load_reader<friend_injection::Addr<T>, 0, _>(int{}))::value
+        class R = typename friend_injection::load_reader<friend_injection::Addr<T>, _>::value::value
     >
     using value = R;
+
+    /// Retrieves the native value stored in the type variable T
+    /// T must hold a ctstd::Num, or any other type with a static member `value`, like the peano integers
+    /// 
+    /// Usage: static_assert(value_v<variable_name, RE> == 42);
+    template <class T, class _>
+    constexpr auto value_v = value<T, _>::value;
 };